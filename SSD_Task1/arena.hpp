@@ -0,0 +1,119 @@
+/**
+ * \file arena.hpp
+ *
+ * \brief Bump allocator for short-lived scratch memory.
+ *
+ * \details This file includes definition of arena handing out memory for decoding a batch of lines, which is released all at once.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef arena_hpp
+#define arena_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <memory>
+
+using std::vector;
+using std::unique_ptr;
+
+//! Default size of a single block of the arena in bytes
+#define ARENA_BLOCK_SIZE (64 * 1024)
+
+/**
+ *    \class        ScratchArena
+ *    \brief        Arena allocating memory by moving a pointer through large blocks
+ *    \details      Memory is never freed separately, reset() makes the whole arena available again.
+ *                  Blocks are kept between resets, so after the first batch of lines the arena does
+ *                  not call the general-purpose allocator anymore.
+ */
+class ScratchArena {
+public:
+    /**
+     *    \fn           ScratchArena(size_t blockSize)
+     *    \brief        Creates arena without any blocks
+     *    \param[in]    blockSize
+     *                    Size of a single block in bytes
+     */
+    explicit ScratchArena(size_t blockSize = ARENA_BLOCK_SIZE)
+    : m_blockSize(blockSize), m_block(0), m_pos(nullptr), m_end(nullptr)
+    {
+    }
+    ScratchArena(const ScratchArena&) = delete;
+    ScratchArena& operator=(const ScratchArena&) = delete;
+
+    /**
+     *    \fn           T* allocate(size_t count)
+     *    \brief        Allocates uninitialized array
+     *    \param[in]    count
+     *                    Number of elements
+     *    \return       Pointer to the array valid until reset() is called
+     *    \tparam       T
+     *                    Trivial type of elements
+     */
+    template <class T>
+    T* allocate(size_t count)
+    {
+        size_t size = count * sizeof(T);
+        uintptr_t pos = (reinterpret_cast<uintptr_t>(m_pos) + alignof(T) - 1) & ~static_cast<uintptr_t>(alignof(T) - 1);
+        if (m_pos == nullptr || pos + size > reinterpret_cast<uintptr_t>(m_end)) {
+            nextBlock(size + alignof(T));
+            pos = (reinterpret_cast<uintptr_t>(m_pos) + alignof(T) - 1) & ~static_cast<uintptr_t>(alignof(T) - 1);
+        }
+        m_pos = reinterpret_cast<char*>(pos + size);
+        return reinterpret_cast<T*>(pos);
+    }
+
+    /**
+     *    \fn           void reset()
+     *    \brief        Releases all allocated memory at once, keeping the blocks for reuse
+     */
+    void reset()
+    {
+        m_block = 0;
+        m_pos = m_blocks.empty() ? nullptr : m_blocks[0].data.get();
+        m_end = m_blocks.empty() ? nullptr : m_pos + m_blocks[0].size;
+    }
+
+    size_t blockCnt() const { return m_blocks.size(); }    /*!< Returns number of blocks allocated so far */
+
+private:
+    /**
+     *    \struct       Block
+     *    \brief        Memory block of the arena
+     */
+    struct Block {
+        unique_ptr<char[]> data;    /*!< Memory of the block */
+        size_t size;                /*!< Size of the block in bytes */
+    };
+
+    /**
+     *    \fn           void nextBlock(size_t size)
+     *    \brief        Moves to the next block which can hold given number of bytes, allocating it if needed
+     *    \param[in]    size
+     *                    Number of bytes needed
+     */
+    void nextBlock(size_t size)
+    {
+        // Skip kept blocks which are too small for the request
+        size_t next = (m_pos == nullptr) ? 0 : m_block + 1;
+        while (next < m_blocks.size() && m_blocks[next].size < size) next++;
+        if (next == m_blocks.size()) {
+            size_t blockSize = (size > m_blockSize) ? size : m_blockSize;
+            m_blocks.push_back(Block{unique_ptr<char[]>(new char[blockSize]), blockSize});
+        }
+        m_block = next;
+        m_pos = m_blocks[next].data.get();
+        m_end = m_pos + m_blocks[next].size;
+    }
+
+    size_t m_blockSize;         /*!< Size of regular blocks in bytes */
+    vector<Block> m_blocks;     /*!< All blocks of the arena */
+    size_t m_block;             /*!< Index of the current block */
+    char* m_pos;                /*!< Next free byte of the current block */
+    char* m_end;                /*!< End of the current block */
+};
+
+#endif /* arena_hpp */
@@ -0,0 +1,225 @@
+/**
+ * \file columns.cpp
+ *
+ * \brief Columnar decoding of position reports.
+ *
+ * \details This file includes definitions of functions decoding batches of position reports into separate arrays of fields.
+ *
+ * \date    16/10/2026
+ */
+
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "columns.hpp"
+#include "schema.hpp"
+
+typedef PositionReportSchema S;
+typedef FieldGroup<S::MessageType, S::MMSI, S::NavigationStatus> HeaderGroup;       /*!< Bits 0-63 */
+typedef FieldGroup<S::SpeedOverGround, S::Longitude> MotionGroup;                  /*!< Bits 48-111 */
+typedef FieldGroup<S::Latitude, S::CourseOverGround> CourseGroup;                  /*!< Bits 88-151 */
+typedef FieldGroup<S::TrueHeading> HeadingGroup;                                    /*!< Bits 128-191 */
+
+/**
+ *    \fn           void PositionColumns::resize(size_t count)
+ *    \brief        Sets number of messages of all arrays
+ *    \param[in]    count
+ *                    Number of messages
+ */
+void PositionColumns::resize(size_t count)
+{
+    size = count;
+    messageType.resize(count);
+    mmsi.resize(count);
+    status.resize(count);
+    sog.resize(count);
+    lon.resize(count);
+    lat.resize(count);
+    cog.resize(count);
+    hdg.resize(count);
+}
+
+/**
+ *    \fn           void decodeRow(const byte* msg, PositionColumns& columns, size_t row)
+ *    \brief        Decodes fields of a single position report into a row of columns
+ *    \param[in]    msg
+ *                    AIS message in binary format
+ *    \param[out]    columns
+ *                    Decoded fields
+ *    \param[in]    row
+ *                    Index of the message in the batch
+ */
+static inline void decodeRow(const byte* msg, PositionColumns& columns, size_t row)
+{
+    unsigned messageType, MMSI, status, speedOverGround, courseOverGround;
+    int longitude, latitude;
+    HeaderGroup::extract(msg, messageType, MMSI, status);
+    MotionGroup::extract(msg, speedOverGround, longitude);
+    CourseGroup::extract(msg, latitude, courseOverGround);
+    columns.messageType[row] = static_cast<byte>(messageType);
+    columns.mmsi[row] = MMSI;
+    columns.status[row] = static_cast<byte>(status);
+    columns.sog[row] = static_cast<uint16_t>(speedOverGround);
+    columns.lon[row] = longitude;
+    columns.lat[row] = latitude;
+    columns.cog[row] = static_cast<uint16_t>(courseOverGround);
+    columns.hdg[row] = static_cast<uint16_t>(S::TrueHeading::extract(msg));
+}
+
+#if defined(__AVX2__)
+/**
+ *    \fn           __m256i loadWords(const byte* base, __m256i offsets)
+ *    \brief        Loads big-endian words of 4 messages
+ *    \param[in]    base
+ *                    Address of the word of the first message of the batch
+ *    \param[in]    offsets
+ *                    Distances of the messages from the first message of the batch in bytes
+ *    \return       Words of the messages in 64-bit lanes
+ */
+static inline __m256i loadWords(const byte* base, __m256i offsets)
+{
+    __m256i words = _mm256_i64gather_epi64(reinterpret_cast<const long long*>(base), offsets, 1);
+    return _mm256_shuffle_epi8(words, _mm256_setr_epi8(
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8,
+        7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8));
+}
+
+/**
+ *    \fn           __m256i extractFields(__m256i low, __m256i high)
+ *    \brief        Extracts raw values of the field of 8 messages
+ *    \param[in]    low
+ *                    Words of messages 0-3 loaded at bit WordOffset
+ *    \param[in]    high
+ *                    Words of messages 4-7 loaded at bit WordOffset
+ *    \return       Raw values of the field in 32-bit lanes
+ *    \tparam       F
+ *                    Field of the schema
+ *    \tparam       WordOffset
+ *                    Index of the bit stored as the most significant bit of the words
+ */
+template <class F, unsigned WordOffset>
+static inline __m256i extractFields(__m256i low, __m256i high)
+{
+    static_assert(F::offset >= WordOffset && F::offset + F::length <= WordOffset + 64, "Field must lie within the loaded word");
+
+    // Move the field to the top of each word and gather upper halves of the words
+    const __m256i upperHalves = _mm256_setr_epi32(1, 3, 5, 7, 1, 3, 5, 7);
+    low = _mm256_permutevar8x32_epi32(_mm256_slli_epi64(low, F::offset - WordOffset), upperHalves);
+    high = _mm256_permutevar8x32_epi32(_mm256_slli_epi64(high, F::offset - WordOffset), upperHalves);
+    __m256i values = _mm256_inserti128_si256(low, _mm256_castsi256_si128(high), 1);
+
+    if (F::isSigned) return _mm256_srai_epi32(values, 32 - F::length);
+    else return _mm256_srli_epi32(values, 32 - F::length);
+}
+
+/**
+ *    \fn           void store32(void* out, __m256i values)
+ *    \brief        Stores 8 values of 32 bits
+ */
+static inline void store32(void* out, __m256i values)
+{
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), values);
+}
+
+/**
+ *    \fn           __m128i narrow16(__m256i values)
+ *    \brief        Narrows 8 values of at most 16 bits stored in 32-bit lanes
+ */
+static inline __m128i narrow16(__m256i values)
+{
+    return _mm256_castsi256_si128(_mm256_permute4x64_epi64(_mm256_packus_epi32(values, values), 0x08));
+}
+
+/**
+ *    \fn           void store16(void* out, __m256i values)
+ *    \brief        Stores 8 values of at most 16 bits
+ */
+static inline void store16(void* out, __m256i values)
+{
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out), narrow16(values));
+}
+
+/**
+ *    \fn           void store8(void* out, __m256i values)
+ *    \brief        Stores 8 values of at most 8 bits
+ */
+static inline void store8(void* out, __m256i values)
+{
+    __m128i words = narrow16(values);
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packus_epi16(words, words));
+}
+#endif
+
+/**
+ *    \fn           void decodeBatch(const AISPayloadView* msgs, size_t count, PositionColumns& columns)
+ *    \brief        Decodes fields of position reports of the whole batch into columns
+ *    \param[in]    msgs
+ *                    Views of packed position reports (types 1, 2 and 3)
+ *    \param[in]    count
+ *                    Number of messages
+ *    \param[out]    columns
+ *                    Decoded fields, resized to the number of messages
+ *    \note         Uses AVX2 instructions decoding 8 messages at once when available, scalar code otherwise
+ */
+void decodeBatch(const AISPayloadView* msgs, size_t count, PositionColumns& columns)
+{
+    columns.resize(count);
+    size_t row = 0;
+
+#if defined(__AVX2__)
+    // Load each group of fields of 8 messages with two gathers and extract all its fields at once
+    for (; row + 8 <= count; row += 8) {
+        const byte* first = msgs[row].data();
+        intptr_t base = reinterpret_cast<intptr_t>(first);
+        __m256i lowOffsets = _mm256_setr_epi64x(0,
+            reinterpret_cast<intptr_t>(msgs[row+1].data()) - base,
+            reinterpret_cast<intptr_t>(msgs[row+2].data()) - base,
+            reinterpret_cast<intptr_t>(msgs[row+3].data()) - base);
+        __m256i highOffsets = _mm256_setr_epi64x(
+            reinterpret_cast<intptr_t>(msgs[row+4].data()) - base,
+            reinterpret_cast<intptr_t>(msgs[row+5].data()) - base,
+            reinterpret_cast<intptr_t>(msgs[row+6].data()) - base,
+            reinterpret_cast<intptr_t>(msgs[row+7].data()) - base);
+
+        __m256i low = loadWords(first + HeaderGroup::wordOffset/8, lowOffsets);
+        __m256i high = loadWords(first + HeaderGroup::wordOffset/8, highOffsets);
+        store8(&columns.messageType[row], extractFields<S::MessageType, HeaderGroup::wordOffset>(low, high));
+        store32(&columns.mmsi[row], extractFields<S::MMSI, HeaderGroup::wordOffset>(low, high));
+        store8(&columns.status[row], extractFields<S::NavigationStatus, HeaderGroup::wordOffset>(low, high));
+
+        low = loadWords(first + MotionGroup::wordOffset/8, lowOffsets);
+        high = loadWords(first + MotionGroup::wordOffset/8, highOffsets);
+        store16(&columns.sog[row], extractFields<S::SpeedOverGround, MotionGroup::wordOffset>(low, high));
+        store32(&columns.lon[row], extractFields<S::Longitude, MotionGroup::wordOffset>(low, high));
+
+        low = loadWords(first + CourseGroup::wordOffset/8, lowOffsets);
+        high = loadWords(first + CourseGroup::wordOffset/8, highOffsets);
+        store32(&columns.lat[row], extractFields<S::Latitude, CourseGroup::wordOffset>(low, high));
+        store16(&columns.cog[row], extractFields<S::CourseOverGround, CourseGroup::wordOffset>(low, high));
+
+        low = loadWords(first + HeadingGroup::wordOffset/8, lowOffsets);
+        high = loadWords(first + HeadingGroup::wordOffset/8, highOffsets);
+        store16(&columns.hdg[row], extractFields<S::TrueHeading, HeadingGroup::wordOffset>(low, high));
+    }
+#endif
+
+    // Scalar processing of the remaining messages
+    for (; row < count; row++) decodeRow(msgs[row].data(), columns, row);
+}
+
+/**
+ *    \fn           PositionColumns decodeBatch(const AISPayloadView* msgs, size_t count)
+ *    \brief        Decodes fields of position reports of the whole batch into new columns
+ *    \param[in]    msgs
+ *                    Views of packed position reports (types 1, 2 and 3)
+ *    \param[in]    count
+ *                    Number of messages
+ *    \return       Decoded fields
+ */
+PositionColumns decodeBatch(const AISPayloadView* msgs, size_t count)
+{
+    PositionColumns columns;
+    decodeBatch(msgs, count, columns);
+    return columns;
+}
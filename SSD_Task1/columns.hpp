@@ -0,0 +1,72 @@
+/**
+ * \file columns.hpp
+ *
+ * \brief Header file of 'columns.cpp'.
+ *
+ * \details This file includes declarations of structures and functions used for decoding batches of position reports into columns of values.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef columns_hpp
+#define columns_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "main.hpp"
+#include "view.hpp"
+
+using std::vector;
+
+/**
+ *    \struct       PositionColumns
+ *    \brief        Structure for storing decoded position reports as separate arrays of fields
+ *    \details      Element i of every array belongs to message i of the decoded batch. Values are
+ *                  kept in units of PositionReport. Arrays keep their capacity between batches.
+ */
+struct PositionColumns {
+    size_t size = 0;                /*!< Number of decoded messages */
+    vector<byte> messageType;       /*!< Message Type */
+    vector<uint32_t> mmsi;          /*!< MMSI */
+    vector<byte> status;            /*!< Navigation Status */
+    vector<uint16_t> sog;           /*!< Speed Over Ground [0.1 knot] */
+    vector<int32_t> lon;            /*!< Longitude [1/10000 min] */
+    vector<int32_t> lat;            /*!< Latitude [1/10000 min] */
+    vector<uint16_t> cog;           /*!< Course Over Ground [0.1 deg] */
+    vector<uint16_t> hdg;           /*!< True Heading [deg] */
+
+    /**
+     *    \fn           void resize(size_t count)
+     *    \brief        Sets number of messages of all arrays
+     *    \param[in]    count
+     *                    Number of messages
+     */
+    void resize(size_t count);
+};
+
+/**
+ *    \fn           void decodeBatch(const AISPayloadView* msgs, size_t count, PositionColumns& columns)
+ *    \brief        Decodes fields of position reports of the whole batch into columns
+ *    \param[in]    msgs
+ *                    Views of packed position reports (types 1, 2 and 3)
+ *    \param[in]    count
+ *                    Number of messages
+ *    \param[out]    columns
+ *                    Decoded fields, resized to the number of messages
+ *    \note         Uses AVX2 instructions decoding 8 messages at once when available, scalar code otherwise
+ */
+void decodeBatch(const AISPayloadView* msgs, size_t count, PositionColumns& columns);
+
+/**
+ *    \fn           PositionColumns decodeBatch(const AISPayloadView* msgs, size_t count)
+ *    \brief        Decodes fields of position reports of the whole batch into new columns
+ *    \param[in]    msgs
+ *                    Views of packed position reports (types 1, 2 and 3)
+ *    \param[in]    count
+ *                    Number of messages
+ *    \return       Decoded fields
+ */
+PositionColumns decodeBatch(const AISPayloadView* msgs, size_t count);
+
+#endif /* columns_hpp */
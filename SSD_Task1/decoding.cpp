@@ -13,86 +13,14 @@
  */
 
 #include <string>
-#include <map>
+#include <cstring>
+#include <cstdint>
+#include <algorithm>
 #include <math.h>
 #include "decoding.hpp"
 
-using namespace std;
-
-/**
- *    \var      map<byte,string> MessageTypes
- *    \brief    Container mapping values of 'Message Type' parameter to proper names
- */
-map<byte,string> MessageTypes;
-/**
- *    \var      map<byte,string> NavigationStatus
- *    \brief    Container mapping values of 'Navigation Status' parameter to proper names
- */
-map<byte,string> NavigationStatus;
-
-
-/**
- *    \fn           void initMessageTypesMap()
- *    \brief        Assigns names to values of 'Message Type' parameter
- *    \note         Used for interpreting parameter values of AIS messages
- *    \warning      This function must be run before using MessageTypes map
- */
-void initMessageTypesMap()
-{
-    MessageTypes[1] = "Position Report Class A";
-    MessageTypes[2] = "Position Report Class A (Assigned schedule)";
-    MessageTypes[3] = "Position Report Class A (Response to interrogation)";
-    MessageTypes[4] = "Base Station Report";
-    MessageTypes[5] = "Static and Voyage Related Data";
-    MessageTypes[6] = "Binary Addressed Message";
-    MessageTypes[7] = "Binary Acknowledge";
-    MessageTypes[8] = "Binary Broadcast Message";
-    MessageTypes[9] = "Standard SAR Aircraft Position Report";
-    MessageTypes[10] = "UTC and Date Inquiry";
-    MessageTypes[11] = "UTC and Date Response";
-    MessageTypes[12] = "Addressed Safety Related Message";
-    MessageTypes[13] = "Safety Related Acknowledgement";
-    MessageTypes[14] = "Safety Related Broadcast Message";
-    MessageTypes[15] = "Interrogation";
-    MessageTypes[16] = "Assignment Mode Command";
-    MessageTypes[17] = "DGNSS Binary Broadcast Message";
-    MessageTypes[18] = "Standard Class B CS Position Report";
-    MessageTypes[19] = "Extended Class B Equipment Position Report";
-    MessageTypes[20] = "Data Link Management";
-    MessageTypes[21] = "Aid-to-Navigation Report";
-    MessageTypes[22] = "Channel Management";
-    MessageTypes[23] = "Group Assignment Command";
-    MessageTypes[24] = "Static Data Report";
-    MessageTypes[25] = "Single Slot Binary Message";
-    MessageTypes[26] = "Multiple Slot Binary Message With Communications State";
-    MessageTypes[27] = "Position Report For Long-Range Applications";
-}
-
-/**
- *    \fn           void initNavigationStatusMap()
- *    \brief        Assigns names to values of 'Navigation Status' parameter
- *    \note         Used for interpreting parameter values of AIS messages
- *    \warning      This function must be run before using NavigationStatus map
- */
-void initNavigationStatusMap()
-{
-    NavigationStatus[0] = "Under way using engine";
-    NavigationStatus[1] = "At anchor";
-    NavigationStatus[2] = "Not under command";
-    NavigationStatus[3] = "Restricted manoeuverability";
-    NavigationStatus[4] = "Constrained by her draught";
-    NavigationStatus[5] = "Moored";
-    NavigationStatus[6] = "Aground";
-    NavigationStatus[7] = "Engaged in Fishing";
-    NavigationStatus[8] = "Under way sailing";
-    NavigationStatus[9] = "Reserved";
-    NavigationStatus[10] = "Reserved";
-    NavigationStatus[11] = "Reserverd";
-    NavigationStatus[12] = "Reserved";
-    NavigationStatus[13] = "Reserved";
-    NavigationStatus[14] = "AIS-SART is active";
-    NavigationStatus[15] = "Not defined";
-}
+using std::string;
+using std::to_string;
 
 /**
  *    \fn           string getMessageType(unsigned MsgType)
@@ -100,12 +28,11 @@ void initNavigationStatusMap()
  *    \param[in]    MsgType
  *                    Value of the parameter 'Message Type'
  *    \return       Textual description of the parameter value
- *    \warning      Requires presence of externally defined MessageTypes map container
  */
 string getMessageType(unsigned MsgType)
 {
-    if (MsgType == 0 || MsgType > 27) return "error";
-    return MessageTypes.at(MsgType);
+    if (MsgType >= MessageTypes.size()) return "error";
+    return string(MessageTypes[MsgType]);
 }
 
 /**
@@ -138,25 +65,23 @@ string getMMSI(unsigned MMSI)
  *    \param[in]    NavStatus
  *                    Value of the parameter 'Navigation Status'
  *    \return       Textual description of the parameter value
- *    \warning      Requires presence of externally defined NavigationStatus map container
  */
 string getNavigationStatus(unsigned NavStatus)
 {
-    if (NavStatus > 15) return "error";
-    return NavigationStatus.at(NavStatus);
+    if (NavStatus >= NavigationStatus.size()) return "error";
+    return string(NavigationStatus[NavStatus]);
 }
 
 /**
- *    \fn           string getRateOfTurn(unsigned RateOfTurn)
+ *    \fn           string getRateOfTurn(int RateOfTurn)
  *    \brief        Interprets value of the parameter 'Rate Of Turn' and returns textual description
  *    \param[in]    RateOfTurn
  *                    Value of the parameter 'Rate Of Turn'
  *    \return       Textual description of the parameter value
  */
-string getRateOfTurn(unsigned RateOfTurn)
+string getRateOfTurn(int RateOfTurn)
 {
-    // Convert to signed byte variable
-    signed char ROT_AIS = (signed char)RateOfTurn;
+    int ROT_AIS = RateOfTurn;
     
     // Handle special case
     if(ROT_AIS == -128) return "not available";
@@ -206,69 +131,126 @@ string getPositionAccuracy(unsigned PositionAccuracy)
 }
 
 /**
- *    \fn           string getLongitude(unsigned Longitude)
+ *    \fn           string getLongitude(int Longitude)
  *    \brief        Interprets value of the parameter 'Longitude' and returns textual description
  *    \param[in]    Longitude
  *                    Value of the parameter 'Longitude'
  *    \return       Textual description of the parameter value
  */
-string getLongitude(unsigned Longitude)
+string getLongitude(int Longitude)
 {
-    // Handle special case
-    if (Longitude == 0x6791AC0) return "not available"; // value of 181 degrees
+    char text[COORDINATE_TEXT_SIZE];
+    return string(text, writeLongitude(Longitude, text));
+}
+
+/**
+ *    \fn           string getLatitude(int Latitude)
+ *    \brief        Interprets value of the parameter 'Latitude' and returns textual description
+ *    \param[in]    Latitude
+ *                    Value of the parameter 'Latitude'
+ *    \return       Textual description of the parameter value
+ */
+string getLatitude(int Latitude)
+{
+    char text[COORDINATE_TEXT_SIZE];
+    return string(text, writeLatitude(Latitude, text));
+}
+
+/**
+ *    \fn           char* appendText(char* out, const char* text, size_t len)
+ *    \brief        Copies text into the buffer
+ *    \param[out]    out
+ *                    Buffer
+ *    \param[in]    text
+ *                    Copied text
+ *    \param[in]    len
+ *                    Length of the text
+ *    \return       Pointer following the last written character
+ */
+static inline char* appendText(char* out, const char* text, size_t len)
+{
+    memcpy(out, text, len);
+    return out + len;
+}
+
+/**
+ *    \fn           char* writeDegrees(int value, char* out)
+ *    \brief        Writes coordinate expressed in [1/10000 min] as degrees with six decimal places
+ *    \param[in]    value
+ *                    Coordinate [1/10000 min]
+ *    \param[out]    out
+ *                    Buffer
+ *    \return       Pointer following the last written character
+ *    \note         Result matches to_string(value/600000.0). One micro-degree equals 0.6 of the unit,
+ *                  so the exact value is 5*|value|/3 micro-degrees and its fraction is never 1/2,
+ *                  hence rounding to the nearest micro-degree is (5*|value|+1)/3.
+ */
+static char* writeDegrees(int value, char* out)
+{
+    uint64_t magnitude = (value < 0) ? -static_cast<int64_t>(value) : value;
+    uint64_t microDegrees = (5*magnitude + 1) / 3;
+    if (value < 0) *out++ = '-';
     
-    // Convert AIS bit value to value expressed in [deg]
-    int signedLongitude = 0;
-    double LON = 0;
+    // Integer part
+    char digits[16];
+    int digitCnt = 0;
+    uint64_t degrees = microDegrees / 1000000;
+    do {
+        digits[digitCnt++] = static_cast<char>('0' + degrees % 10);
+        degrees /= 10;
+    } while (degrees > 0);
+    while (digitCnt > 0) *out++ = digits[--digitCnt];
     
-    if (Longitude & 0x08000000) {   // negative value
-        signedLongitude = (Longitude & 0x07FFFFFF) - 0x08000000;
-        LON = static_cast<double>(signedLongitude);
-        LON /= 600000.0;
-        if (LON < -180.0) return "error";
-    }
-    else {                          // positive value
-        signedLongitude = Longitude & 0x07FFFFFF;
-        LON = static_cast<double>(signedLongitude);
-        LON /= 600000.0;
-        if (LON > 180.0) return "error";
+    // Fractional part
+    *out++ = '.';
+    unsigned fraction = static_cast<unsigned>(microDegrees % 1000000);
+    for (int k = 5; k >= 0; k--) {
+        out[k] = static_cast<char>('0' + fraction % 10);
+        fraction /= 10;
     }
+    return out + 6;
+}
+
+/**
+ *    \fn           char* writeLongitude(int Longitude, char* out)
+ *    \brief        Writes textual description of the parameter 'Longitude' into the buffer
+ *    \param[in]    Longitude
+ *                    Value of the parameter 'Longitude'
+ *    \param[out]    out
+ *                    Buffer of at least COORDINATE_TEXT_SIZE bytes
+ *    \return       Pointer following the last written character
+ *    \note         Produces the same text as getLongitude() without floating point arithmetic
+ */
+char* writeLongitude(int Longitude, char* out)
+{
+    // Handle special case
+    if (Longitude == 0x6791AC0) return appendText(out, "not available", 13); // value of 181 degrees
     
-    // Return value
-    return to_string(LON) + " [deg]";
+    // Value must lie within [-180, 180] degrees
+    if (Longitude < -108000000 || Longitude > 108000000) return appendText(out, "error", 5);
+    
+    return appendText(writeDegrees(Longitude, out), " [deg]", 6);
 }
 
 /**
- *    \fn           string getLatitude(unsigned Latitude)
- *    \brief        Interprets value of the parameter 'Latitude' and returns textual description
+ *    \fn           char* writeLatitude(int Latitude, char* out)
+ *    \brief        Writes textual description of the parameter 'Latitude' into the buffer
  *    \param[in]    Latitude
  *                    Value of the parameter 'Latitude'
- *    \return       Textual description of the parameter value
+ *    \param[out]    out
+ *                    Buffer of at least COORDINATE_TEXT_SIZE bytes
+ *    \return       Pointer following the last written character
+ *    \note         Produces the same text as getLatitude() without floating point arithmetic
  */
-string getLatitude(unsigned Latitude)
+char* writeLatitude(int Latitude, char* out)
 {
     // Handle special case
-    if (Latitude == 0x3412140) return "not available"; // value of 91 degrees
+    if (Latitude == 0x3412140) return appendText(out, "not available", 13); // value of 91 degrees
     
-    // Convert AIS bit value to value expressed in [deg]
-    int signedLatitude = 0;
-    double LAT = 0;
-    
-    if (Latitude & 0x04000000) {   // negative value
-        signedLatitude = (Latitude & 0x03FFFFFF) - 0x04000000;
-        LAT = static_cast<double>(signedLatitude);
-        LAT /= 600000.0;
-        if (LAT < -90.0) return "error";
-    }
-    else {                          // positive value
-        signedLatitude = Latitude & 0x03FFFFFF;
-        LAT = static_cast<double>(signedLatitude);
-        LAT /= 600000.0;
-        if (LAT > 90.0) return "error";
-    }
+    // Value must lie within [-90, 90] degrees
+    if (Latitude < -54000000 || Latitude > 54000000) return appendText(out, "error", 5);
     
-    // Return value
-    return to_string(LAT) + " [deg]";
+    return appendText(writeDegrees(Latitude, out), " [deg]", 6);
 }
 
 /**
@@ -364,3 +346,55 @@ string getRAIMFlag(unsigned RAIMFlag)
     else if(RAIMFlag == 0) return "not in use";
     else return "error";
 }
+
+/**
+ *    \fn           void renderField(RenderedField& field, const string& text)
+ *    \brief        Stores textual description of a parameter value
+ *    \param[out]    field
+ *                    Pre-rendered field
+ *    \param[in]    text
+ *                    Textual description of the parameter value
+ */
+static void renderField(RenderedField& field, const string& text)
+{
+    field.len = static_cast<byte>(std::min(text.size(), sizeof(field.text)));
+    memcpy(field.text, text.data(), field.len);
+}
+
+/**
+ *    \fn           void fillRenderTables(RenderTables& tables)
+ *    \brief        Renders every raw value of parameters with small domains
+ *    \param[out]    tables
+ *                    Tables of descriptions
+ */
+static void fillRenderTables(RenderTables& tables)
+{
+    for (unsigned value = 0; value < tables.messageType.size(); value++) {
+        tables.messageType[value] = (value < MessageTypes.size()) ? MessageTypes[value] : string_view("error");
+    }
+    for (unsigned value = 0; value < tables.navigationStatus.size(); value++) renderField(tables.navigationStatus[value], getNavigationStatus(value));
+    for (unsigned value = 0; value < tables.rateOfTurn.size(); value++) renderField(tables.rateOfTurn[value], getRateOfTurn(static_cast<signed char>(value)));
+    for (unsigned value = 0; value < tables.speedOverGround.size(); value++) renderField(tables.speedOverGround[value], getSpeedOverGround(value));
+    for (unsigned value = 0; value < tables.positionAccuracy.size(); value++) renderField(tables.positionAccuracy[value], getPositionAccuracy(value));
+    for (unsigned value = 0; value < tables.courseOverGround.size(); value++) renderField(tables.courseOverGround[value], getCourseOverGround(value));
+    for (unsigned value = 0; value < tables.trueHeading.size(); value++) renderField(tables.trueHeading[value], getTrueHeading(value));
+    for (unsigned value = 0; value < tables.timeStamp.size(); value++) renderField(tables.timeStamp[value], getTimeStamp(value));
+    for (unsigned value = 0; value < tables.maneuverIndicator.size(); value++) renderField(tables.maneuverIndicator[value], getManeuverIndicator(value));
+}
+
+/**
+ *    \fn           const RenderTables& getRenderTables()
+ *    \brief        Returns tables of descriptions of parameters with small domains
+ *    \return       Reference to the tables
+ *    \note         Tables are filled by the get* functions on the first call, so they always produce
+ *                  the same text. Initialization is thread-safe.
+ */
+const RenderTables& getRenderTables()
+{
+    static const RenderTables tables = []() {
+        RenderTables filled;
+        fillRenderTables(filled);
+        return filled;
+    }();
+    return tables;
+}
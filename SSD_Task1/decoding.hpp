@@ -13,25 +13,115 @@
 #define decoding_hpp
 
 #include <string>
-#include <map>
+#include <string_view>
+#include <array>
 #include "main.hpp"
 
-using namespace std;
+using std::string;
+using std::string_view;
+using std::array;
 
 /**
- *    \fn           void initMessageTypesMap()
- *    \brief        Assigns names to values of 'Message Type' parameter
- *    \note         Used for interpreting parameter values of AIS messages
- *    \warning      This function must be run before using MessageTypes map
+ *    \var      MessageTypes
+ *    \brief    Table of names of 'Message Type' parameter values indexed by the value
+ *    \note     Value 0 is not used by AIVDM protocol
  */
-void initMessageTypesMap();
+inline constexpr array<string_view, 28> MessageTypes = {{
+    "error",
+    "Position Report Class A",
+    "Position Report Class A (Assigned schedule)",
+    "Position Report Class A (Response to interrogation)",
+    "Base Station Report",
+    "Static and Voyage Related Data",
+    "Binary Addressed Message",
+    "Binary Acknowledge",
+    "Binary Broadcast Message",
+    "Standard SAR Aircraft Position Report",
+    "UTC and Date Inquiry",
+    "UTC and Date Response",
+    "Addressed Safety Related Message",
+    "Safety Related Acknowledgement",
+    "Safety Related Broadcast Message",
+    "Interrogation",
+    "Assignment Mode Command",
+    "DGNSS Binary Broadcast Message",
+    "Standard Class B CS Position Report",
+    "Extended Class B Equipment Position Report",
+    "Data Link Management",
+    "Aid-to-Navigation Report",
+    "Channel Management",
+    "Group Assignment Command",
+    "Static Data Report",
+    "Single Slot Binary Message",
+    "Multiple Slot Binary Message With Communications State",
+    "Position Report For Long-Range Applications"
+}};
+
+/**
+ *    \var      NavigationStatus
+ *    \brief    Table of names of 'Navigation Status' parameter values indexed by the value
+ */
+inline constexpr array<string_view, 16> NavigationStatus = {{
+    "Under way using engine",
+    "At anchor",
+    "Not under command",
+    "Restricted manoeuverability",
+    "Constrained by her draught",
+    "Moored",
+    "Aground",
+    "Engaged in Fishing",
+    "Under way sailing",
+    "Reserved",
+    "Reserved",
+    "Reserverd",
+    "Reserved",
+    "Reserved",
+    "AIS-SART is active",
+    "Not defined"
+}};
+
+//! Size of buffer sufficient for textual description of longitude or latitude
+#define COORDINATE_TEXT_SIZE 32
+//! Size of a single pre-rendered field value in bytes
+#define RENDERED_FIELD_SIZE 32
+
+/**
+ *    \struct       RenderedField
+ *    \brief        Structure for storing pre-rendered textual description of a parameter value
+ */
+struct RenderedField {
+    byte len;                               /*!< Length of the description */
+    char text[RENDERED_FIELD_SIZE - 1];     /*!< Description (not null-terminated) */
+
+    string_view view() const { return string_view(text, len); }    /*!< Returns view of the description */
+};
+
+/**
+ *    \struct       RenderTables
+ *    \brief        Structure for storing descriptions of every raw value of parameters with small domains
+ *    \details      Tables are indexed by raw field values, so they cover all values which fit into
+ *                  the bit length of the field, including the invalid ones.
+ */
+struct RenderTables {
+    array<string_view, 64> messageType;             /*!< Message Type (6 bits), names are too long to be copied */
+    array<RenderedField, 16> navigationStatus;      /*!< Navigation Status (4 bits) */
+    array<RenderedField, 256> rateOfTurn;           /*!< Rate Of Turn (8 bits, indexed by value cast to byte) */
+    array<RenderedField, 1024> speedOverGround;     /*!< Speed Over Ground (10 bits) */
+    array<RenderedField, 2> positionAccuracy;       /*!< Position Accuracy (1 bit) */
+    array<RenderedField, 4096> courseOverGround;    /*!< Course Over Ground (12 bits) */
+    array<RenderedField, 512> trueHeading;          /*!< True Heading (9 bits) */
+    array<RenderedField, 64> timeStamp;             /*!< Time Stamp (6 bits) */
+    array<RenderedField, 4> maneuverIndicator;      /*!< Maneuver Indicator (2 bits) */
+};
+
 /**
- *    \fn           void initNavigationStatusMap()
- *    \brief        Assigns names to values of 'Navigation Status' parameter
- *    \note         Used for interpreting parameter values of AIS messages
- *    \warning      This function must be run before using NavigationStatus map
+ *    \fn           const RenderTables& getRenderTables()
+ *    \brief        Returns tables of descriptions of parameters with small domains
+ *    \return       Reference to the tables
+ *    \note         Tables are filled by the get* functions on the first call, so they always produce
+ *                  the same text. Initialization is thread-safe.
  */
-void initNavigationStatusMap();
+const RenderTables& getRenderTables();
 
 /**
  *    \fn           string getMessageType(unsigned MsgType)
@@ -39,7 +129,6 @@ void initNavigationStatusMap();
  *    \param[in]    MsgType
  *                    Value of the parameter 'Message Type'
  *    \return       Textual description of the parameter value
- *    \warning      Requires presence of externally defined MessageTypes map container
  */
 string getMessageType(unsigned MsgType);
 /**
@@ -64,17 +153,16 @@ string getMMSI(unsigned MMSI);
  *    \param[in]    NavStatus
  *                    Value of the parameter 'Navigation Status'
  *    \return       Textual description of the parameter value
- *    \warning      Requires presence of externally defined NavigationStatus map container
  */
 string getNavigationStatus(unsigned NavStatus);
 /**
- *    \fn           string getRateOfTurn(unsigned RateOfTurn)
+ *    \fn           string getRateOfTurn(int RateOfTurn)
  *    \brief        Interprets value of the parameter 'Rate Of Turn' and returns textual description
  *    \param[in]    RateOfTurn
  *                    Value of the parameter 'Rate Of Turn'
  *    \return       Textual description of the parameter value
  */
-string getRateOfTurn(unsigned RateOfTurn);
+string getRateOfTurn(int RateOfTurn);
 /**
  *    \fn           string getSpeedOverGround(unsigned SpeedOverGround)
  *    \brief        Interprets value of the parameter 'Speed Over Ground' and returns textual description
@@ -92,21 +180,43 @@ string getSpeedOverGround(unsigned SpeedOverGround);
  */
 string getPositionAccuracy(unsigned PositionAccuracy);
 /**
- *    \fn           string getLongitude(unsigned Longitude)
+ *    \fn           string getLongitude(int Longitude)
  *    \brief        Interprets value of the parameter 'Longitude' and returns textual description
  *    \param[in]    Longitude
  *                    Value of the parameter 'Longitude'
  *    \return       Textual description of the parameter value
  */
-string getLongitude(unsigned Longitude);
+string getLongitude(int Longitude);
 /**
- *    \fn           string getLatitude(unsigned Latitude)
+ *    \fn           string getLatitude(int Latitude)
  *    \brief        Interprets value of the parameter 'Latitude' and returns textual description
  *    \param[in]    Latitude
  *                    Value of the parameter 'Latitude'
  *    \return       Textual description of the parameter value
  */
-string getLatitude(unsigned Latitude);
+string getLatitude(int Latitude);
+/**
+ *    \fn           char* writeLongitude(int Longitude, char* out)
+ *    \brief        Writes textual description of the parameter 'Longitude' into the buffer
+ *    \param[in]    Longitude
+ *                    Value of the parameter 'Longitude'
+ *    \param[out]    out
+ *                    Buffer of at least COORDINATE_TEXT_SIZE bytes
+ *    \return       Pointer following the last written character
+ *    \note         Produces the same text as getLongitude() without floating point arithmetic
+ */
+char* writeLongitude(int Longitude, char* out);
+/**
+ *    \fn           char* writeLatitude(int Latitude, char* out)
+ *    \brief        Writes textual description of the parameter 'Latitude' into the buffer
+ *    \param[in]    Latitude
+ *                    Value of the parameter 'Latitude'
+ *    \param[out]    out
+ *                    Buffer of at least COORDINATE_TEXT_SIZE bytes
+ *    \return       Pointer following the last written character
+ *    \note         Produces the same text as getLatitude() without floating point arithmetic
+ */
+char* writeLatitude(int Latitude, char* out);
 /**
  *    \fn           string getCourseOverGround(unsigned CourseOverGround)
  *    \brief        Interprets value of the parameter 'Course Over Ground' and returns textual description
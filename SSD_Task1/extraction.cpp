@@ -10,312 +10,325 @@
  */
 
 #include <string>
-#include <map>
+#include <string_view>
+#include <cstring>
+#include <cstdint>
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#endif
 #include "extraction.hpp"
+#include "schema.hpp"
 
 /**
- *    \var      map<char,byte> ASCIItoBytes
- *    \brief    Container mapping ASCII chars to binary values
- */
-map<char,byte> ASCIItoBytes;
-
-/**
- *    \fn           void initASCIIToBytesMap()
- *    \brief        Assigns binary values to ASCII characters
- *    \note         Used for decoding AIS messages
- *    \warning      This function must be run before using ASCIItoBytes map
- */
-void initASCIIToBytesMap()
-{
-    ASCIItoBytes['0'] = 0b000000;
-    ASCIItoBytes['1'] = 0b000001;
-    ASCIItoBytes['2'] = 0b000010;
-    ASCIItoBytes['3'] = 0b000011;
-    ASCIItoBytes['4'] = 0b000100;
-    ASCIItoBytes['5'] = 0b000101;
-    ASCIItoBytes['6'] = 0b000110;
-    ASCIItoBytes['7'] = 0b000111;
-    ASCIItoBytes['8'] = 0b001000;
-    ASCIItoBytes['9'] = 0b001001;
-    ASCIItoBytes[':'] = 0b001010;
-    ASCIItoBytes[';'] = 0b001011;
-    ASCIItoBytes['<'] = 0b001100;
-    ASCIItoBytes['='] = 0b001101;
-    ASCIItoBytes['>'] = 0b001110;
-    ASCIItoBytes['?'] = 0b001111;
-    ASCIItoBytes['@'] = 0b010000;
-    ASCIItoBytes['A'] = 0b010001;
-    ASCIItoBytes['B'] = 0b010010;
-    ASCIItoBytes['C'] = 0b010011;
-    ASCIItoBytes['D'] = 0b010100;
-    ASCIItoBytes['E'] = 0b010101;
-    ASCIItoBytes['F'] = 0b010110;
-    ASCIItoBytes['G'] = 0b010111;
-    ASCIItoBytes['H'] = 0b011000;
-    ASCIItoBytes['I'] = 0b011001;
-    ASCIItoBytes['J'] = 0b011010;
-    ASCIItoBytes['K'] = 0b011011;
-    ASCIItoBytes['L'] = 0b011100;
-    ASCIItoBytes['M'] = 0b011101;
-    ASCIItoBytes['N'] = 0b011110;
-    ASCIItoBytes['O'] = 0b011111;
-    ASCIItoBytes['P'] = 0b100000;
-    ASCIItoBytes['Q'] = 0b100001;
-    ASCIItoBytes['R'] = 0b100010;
-    ASCIItoBytes['S'] = 0b100011;
-    ASCIItoBytes['T'] = 0b100100;
-    ASCIItoBytes['U'] = 0b100101;
-    ASCIItoBytes['V'] = 0b100110;
-    ASCIItoBytes['W'] = 0b100111;
-    ASCIItoBytes['\''] = 0b101000;
-    ASCIItoBytes['a'] = 0b101001;
-    ASCIItoBytes['b'] = 0b101010;
-    ASCIItoBytes['c'] = 0b101011;
-    ASCIItoBytes['d'] = 0b101100;
-    ASCIItoBytes['e'] = 0b101101;
-    ASCIItoBytes['f'] = 0b101101;
-    ASCIItoBytes['g'] = 0b101111;
-    ASCIItoBytes['h'] = 0b110000;
-    ASCIItoBytes['i'] = 0b110001;
-    ASCIItoBytes['j'] = 0b110010;
-    ASCIItoBytes['k'] = 0b110011;
-    ASCIItoBytes['l'] = 0b110100;
-    ASCIItoBytes['m'] = 0b110101;
-    ASCIItoBytes['n'] = 0b110110;
-    ASCIItoBytes['o'] = 0b110111;
-    ASCIItoBytes['p'] = 0b111000;
-    ASCIItoBytes['q'] = 0b111001;
-    ASCIItoBytes['r'] = 0b111010;
-    ASCIItoBytes['s'] = 0b111011;
-    ASCIItoBytes['t'] = 0b111100;
-    ASCIItoBytes['u'] = 0b111101;
-    ASCIItoBytes['v'] = 0b111110;
-    ASCIItoBytes['w'] = 0b111111;
-}
-
-/**
- *    \fn           void convertAISMsgStringToBinaryFormat(string& msgString, byte* msgBin)
+ *    \fn           bool convertAISMsgStringToBinaryFormat(string_view msgString, byte* msgBin)
  *    \brief        Converts AIS message string into byte array
+ *    \details      6-bit values of subsequent characters are packed into a dense big-endian
+ *                  bit stream, i.e. bit 0 of the message is the most significant bit of msgBin[0].
  *    \param[in]    msgString
  *                    AIS message string
  *    \param[out]    msgBin
  *                    Pointer to byte array
- *    \warning      msgBin must point to already allocated memory
+ *    \return       Boolean value determining if all characters belong to the sixbit alphabet
+ *    \note         Uses AVX2 or SSSE3 instructions when available, scalar code otherwise
+ *    \warning      msgBin must point to already allocated memory of packedPayloadSize(msgString.length()) bytes
  */
-void convertAISMsgStringToBinaryFormat(string& msgString, byte* msgBin)
+bool convertAISMsgStringToBinaryFormat(string_view msgString, byte* msgBin)
 {
-    for (int i = 0; i < msgString.length(); i++) {
-        msgBin[i] = ASCIItoBytes[msgString.at(i)];
+    const char* msg = msgString.data();
+    size_t len = msgString.length();
+    size_t i = 0;
+    byte* out = msgBin;
+    bool invalid = false;
+
+#if defined(__AVX2__)
+    // Convert 32 characters into 24 bytes at once
+    for (; i + 32 <= len; i += 32, out += 24) {
+        __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(msg + i));
+        
+        // Characters must be in range '0'-'W' or '`'-'w'
+        __m256i valid = _mm256_or_si256(
+            _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('0' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('W' + 1), chars)),
+            _mm256_and_si256(_mm256_cmpgt_epi8(chars, _mm256_set1_epi8('`' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('w' + 1), chars)));
+        invalid |= (_mm256_movemask_epi8(valid) != -1);
+        
+        // De-armor: subtract 48, and another 8 if the result exceeds 40
+        __m256i values = _mm256_sub_epi8(chars, _mm256_set1_epi8(48));
+        values = _mm256_sub_epi8(values, _mm256_and_si256(_mm256_cmpgt_epi8(values, _mm256_set1_epi8(40)), _mm256_set1_epi8(8)));
+        
+        // Merge pairs of 6-bit values into 12 bits and pairs of those into 24 bits
+        values = _mm256_maddubs_epi16(values, _mm256_set1_epi32(0x01400140));
+        values = _mm256_madd_epi16(values, _mm256_set1_epi32(0x00011000));
+        
+        // Store 3 bytes of each 32-bit lane in big-endian order, 12 bytes per 128-bit half
+        values = _mm256_shuffle_epi8(values, _mm256_setr_epi8(
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+            2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm256_castsi256_si128(values));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 12), _mm256_extracti128_si256(values, 1));
+    }
+#endif
+#if defined(__SSSE3__) || defined(__AVX2__)
+    // Convert 16 characters into 12 bytes at once
+    for (; i + 16 <= len; i += 16, out += 12) {
+        __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(msg + i));
+        
+        // Characters must be in range '0'-'W' or '`'-'w'
+        __m128i valid = _mm_or_si128(
+            _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('W' + 1))),
+            _mm_and_si128(_mm_cmpgt_epi8(chars, _mm_set1_epi8('`' - 1)), _mm_cmplt_epi8(chars, _mm_set1_epi8('w' + 1))));
+        invalid |= (_mm_movemask_epi8(valid) != 0xFFFF);
+        
+        // De-armor: subtract 48, and another 8 if the result exceeds 40
+        __m128i values = _mm_sub_epi8(chars, _mm_set1_epi8(48));
+        values = _mm_sub_epi8(values, _mm_and_si128(_mm_cmpgt_epi8(values, _mm_set1_epi8(40)), _mm_set1_epi8(8)));
+        
+        // Merge pairs of 6-bit values into 12 bits and pairs of those into 24 bits
+        values = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+        values = _mm_madd_epi16(values, _mm_set1_epi32(0x00011000));
+        
+        // Store 3 bytes of each 32-bit lane in big-endian order
+        values = _mm_shuffle_epi8(values, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), values);
     }
+#endif
+
+    // Scalar processing of the remaining characters
+    unsigned bitBuffer = 0;
+    unsigned bitCnt = 0;
+    for (; i < len; i++) {
+        byte value = ASCIItoBytes[static_cast<unsigned char>(msg[i])];
+        invalid |= (value == SIXBIT_INVALID);
+        bitBuffer = (bitBuffer << 6) | (value & 0x3F);
+        bitCnt += 6;
+        if (bitCnt >= 8) {
+            bitCnt -= 8;
+            *out++ = static_cast<byte>(bitBuffer >> bitCnt);
+        }
+    }
+    if (bitCnt > 0) *out++ = static_cast<byte>(bitBuffer << (8 - bitCnt));
+    
+    // Clear padding so that fields exceeding short messages read zeros
+    memset(out, 0, (msgBin + packedPayloadSize(len)) - out);
+    
+    return !invalid;
 }
 
 /**
- *    \fn           unsigned getFieldValue(byte* msg, byte idx, byte len)
+ *    \fn           unsigned getFieldValue(const byte* msg, unsigned idx, unsigned len)
  *    \brief        Extracts value from byte array given starting bit index and lenght of bit field
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \param[in]    idx
  *                    Index of the starting bit
  *    \param[in]    len
- *                    Length of bit fied
+ *                    Length of bit fied (1-32)
  *    \return       Value included in bit field
+ *    \warning      8 bytes starting at byte containing bit idx must be readable
  */
-unsigned getFieldValue(byte* msg, byte idx, byte len)
+unsigned getFieldValue(const byte* msg, unsigned idx, unsigned len)
 {
-    unsigned value = 0x0000;
-    
-    for (int i = 0; i < len; i++) {
-        
-        byte byteIdx = (idx+i)/6;
-        byte byteMask = 0b00100000 >> ((idx+i)%6);
-        byte outputBitShift = len-i-1;
-        byte outputBitValue = (msg[byteIdx] & byteMask) ? 1 : 0;
-        /*
-         cout << "ByteIdx: " <<(unsigned short)byteIdx << " ByteVal: " << bitset<8>(msg[byteIdx]) << " ByteMask: " << bitset<8>(byteMask) << " Extracted: " << bitset<8>(msg[byteIdx] & byteMask) << " BitValue: " << (unsigned short)outputBitValue << " BitShift: " << (unsigned short)outputBitShift << endl;
-         */
-        value |= (outputBitValue << outputBitShift);
-    }
-    //cout << "Final output value: " << bitset<32>(value) << " = " << (unsigned)value << endl;
-    
-    return value;
+    // Field of up to 32 bits always fits into the word loaded at its first byte
+    uint64_t word = loadBigEndian64(msg + idx/8) << (idx%8);
+    return static_cast<unsigned>(word >> (64 - len));
+}
+
+/**
+ *    \fn           int getSignedFieldValue(const byte* msg, unsigned idx, unsigned len)
+ *    \brief        Extracts two's complement value from byte array given starting bit index and lenght of bit field
+ *    \param[in]    msg
+ *                    AIS message in binary format
+ *    \param[in]    idx
+ *                    Index of the starting bit
+ *    \param[in]    len
+ *                    Length of bit fied (1-32)
+ *    \return       Sign extended value included in bit field
+ *    \warning      8 bytes starting at byte containing bit idx must be readable
+ */
+int getSignedFieldValue(const byte* msg, unsigned idx, unsigned len)
+{
+    // Arithmetic shift of the left aligned field extends its sign bit
+    int64_t word = static_cast<int64_t>(loadBigEndian64(msg + idx/8) << (idx%8));
+    return static_cast<int>(word >> (64 - len));
 }
 
 /**
- *    \fn           unsigned extractMessageType(byte* msg)
+ *    \fn           unsigned extractMessageType(const byte* msg)
  *    \brief        Extracts value of parameter 'Message Type' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Message Type'
  */
-unsigned extractMessageType(byte* msg)
+unsigned extractMessageType(const byte* msg)
 {
-    return getFieldValue(msg, 0, 6);
+    return PositionReportSchema::MessageType::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractRepeatIndicator(byte* msg)
+ *    \fn           unsigned extractRepeatIndicator(const byte* msg)
  *    \brief        Extracts value of parameter 'Repeat Indicator' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Repeat Indicator'
  */
-unsigned extractRepeatIndicator(byte* msg)
+unsigned extractRepeatIndicator(const byte* msg)
 {
-    return getFieldValue(msg, 6, 2);
+    return PositionReportSchema::RepeatIndicator::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractMMSI(byte* msg)
+ *    \fn           unsigned extractMMSI(const byte* msg)
  *    \brief        Extracts value of parameter 'MMSI' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'MMSI'
  */
-unsigned extractMMSI(byte* msg)
+unsigned extractMMSI(const byte* msg)
 {
-    return getFieldValue(msg, 8, 30);
+    return PositionReportSchema::MMSI::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractNavigationStatus(byte* msg)
+ *    \fn           unsigned extractNavigationStatus(const byte* msg)
  *    \brief        Extracts value of parameter 'Navigation Status' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Navigation Status'
  */
-unsigned extractNavigationStatus(byte* msg)
+unsigned extractNavigationStatus(const byte* msg)
 {
-    return getFieldValue(msg, 38, 4);
+    return PositionReportSchema::NavigationStatus::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractRateOfTurn(byte* msg)
+ *    \fn           int extractRateOfTurn(const byte* msg)
  *    \brief        Extracts value of parameter 'Rate Of Turn' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Rate Of Turn'
  */
-unsigned extractRateOfTurn(byte* msg)
+int extractRateOfTurn(const byte* msg)
 {
-    return getFieldValue(msg, 42, 8);
+    return PositionReportSchema::RateOfTurn::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractSpeedOverGround(byte* msg)
+ *    \fn           unsigned extractSpeedOverGround(const byte* msg)
  *    \brief        Extracts value of parameter 'Speed Over Ground' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Speed Over Ground'
  */
-unsigned extractSpeedOverGround(byte* msg)
+unsigned extractSpeedOverGround(const byte* msg)
 {
-    return getFieldValue(msg, 50, 10);
+    return PositionReportSchema::SpeedOverGround::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractPositionAccuracy(byte* msg)
+ *    \fn           unsigned extractPositionAccuracy(const byte* msg)
  *    \brief        Extracts value of parameter 'Position Accuracy' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Position Accuracy'
  */
-unsigned extractPositionAccuracy(byte* msg)
+unsigned extractPositionAccuracy(const byte* msg)
 {
-    return getFieldValue(msg, 60, 1);
+    return PositionReportSchema::PositionAccuracy::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractLongitude(byte* msg)
+ *    \fn           int extractLongitude(const byte* msg)
  *    \brief        Extracts value of parameter 'Longitude' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Longitude'
  */
-unsigned extractLongitude(byte* msg)
+int extractLongitude(const byte* msg)
 {
-    return getFieldValue(msg, 61, 28);
+    return PositionReportSchema::Longitude::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractLatitude(byte* msg)
+ *    \fn           int extractLatitude(const byte* msg)
  *    \brief        Extracts value of parameter 'Latitude' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Latitude'
  */
-unsigned extractLatitude(byte* msg)
+int extractLatitude(const byte* msg)
 {
-    return getFieldValue(msg, 89, 27);
+    return PositionReportSchema::Latitude::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractCourseOverGround(byte* msg)
+ *    \fn           unsigned extractCourseOverGround(const byte* msg)
  *    \brief        Extracts value of parameter 'Course Over Ground' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Course Over Ground'
  */
-unsigned extractCourseOverGround(byte* msg)
+unsigned extractCourseOverGround(const byte* msg)
 {
-    return getFieldValue(msg, 116, 12);
+    return PositionReportSchema::CourseOverGround::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractTrueHeading(byte* msg)
+ *    \fn           unsigned extractTrueHeading(const byte* msg)
  *    \brief        Extracts value of parameter 'True Heading' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'True Heading'
  */
-unsigned extractTrueHeading(byte* msg)
+unsigned extractTrueHeading(const byte* msg)
 {
-    return getFieldValue(msg, 128, 9);
+    return PositionReportSchema::TrueHeading::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractTimeStamp(byte* msg)
+ *    \fn           unsigned extractTimeStamp(const byte* msg)
  *    \brief        Extracts value of parameter 'Time Stamp' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Time Stamp'
  */
-unsigned extractTimeStamp(byte* msg)
+unsigned extractTimeStamp(const byte* msg)
 {
-    return getFieldValue(msg, 137, 6);
+    return PositionReportSchema::TimeStamp::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractManeuverIndicator(byte* msg)
+ *    \fn           unsigned extractManeuverIndicator(const byte* msg)
  *    \brief        Extracts value of parameter 'Maneuver Indicator' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Maneuver Indicator'
  */
-unsigned extractManeuverIndicator(byte* msg)
+unsigned extractManeuverIndicator(const byte* msg)
 {
-    return getFieldValue(msg, 143, 2);
+    return PositionReportSchema::ManeuverIndicator::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractRAIMFlag(byte* msg)
+ *    \fn           unsigned extractRAIMFlag(const byte* msg)
  *    \brief        Extracts value of parameter 'RAIM Flag' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'RAIM Flag'
  */
-unsigned extractRAIMFlag(byte* msg)
+unsigned extractRAIMFlag(const byte* msg)
 {
-    return getFieldValue(msg, 148, 1);
+    return PositionReportSchema::RAIMFlag::extract(msg);
 }
 
 /**
- *    \fn           unsigned extractRadioStatus(byte* msg)
+ *    \fn           unsigned extractRadioStatus(const byte* msg)
  *    \brief        Extracts value of parameter 'Radio Status' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Radio Status'
  */
-unsigned extractRadioStatus(byte* msg)
+unsigned extractRadioStatus(const byte* msg)
 {
-    return getFieldValue(msg, 149, 19);
+    return PositionReportSchema::RadioStatus::extract(msg);
 }
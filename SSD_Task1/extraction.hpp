@@ -13,163 +13,242 @@
 #define extraction_hpp
 
 #include <string>
-#include <map>
+#include <string_view>
+#include <array>
+#include <cstddef>
 #include "main.hpp"
 
-using namespace std;
+using std::string;
+using std::string_view;
+using std::array;
+
+//! Value of ASCIItoBytes entries for characters not belonging to the sixbit alphabet
+#define SIXBIT_INVALID 0xFF
+
+/**
+ *    \fn           constexpr array<byte,256> makeASCIIToBytesTable()
+ *    \brief        Assigns binary values to ASCII characters according to AIVDM payload armoring
+ *    \return       Table mapping every ASCII character to its 6-bit value or SIXBIT_INVALID
+ *    \note         Valid characters are '0'-'W' (values 0-39) and '`'-'w' (values 40-63)
+ */
+constexpr array<byte,256> makeASCIIToBytesTable()
+{
+    array<byte,256> table {};
+    for (int c = 0; c < 256; c++) {
+        if (c >= '0' && c <= 'W') table[c] = static_cast<byte>(c - 48);
+        else if (c >= '`' && c <= 'w') table[c] = static_cast<byte>(c - 56);
+        else table[c] = SIXBIT_INVALID;
+    }
+    return table;
+}
 
 /**
- *    \fn           void initASCIIToBytesMap()
- *    \brief        Assigns binary values to ASCII characters
- *    \note         Used for decoding AIS messages
- *    \warning      This function must be run before using ASCIItoBytes map
+ *    \var      constexpr array<byte,256> ASCIItoBytes
+ *    \brief    Table mapping ASCII chars to binary values
  */
-void initASCIIToBytesMap();
+constexpr array<byte,256> ASCIItoBytes = makeASCIIToBytesTable();
+
+/**
+ *    \fn           constexpr bool checkASCIIToBytesTable()
+ *    \brief        Verifies all entries of ASCIItoBytes table against AIVDM sixbit alphabet
+ *    \return       Boolean value determining if table is correct
+ */
+constexpr bool checkASCIIToBytesTable()
+{
+    // Payload armoring alphabet listed in order of the encoded values
+    const char alphabet[] = "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVW`abcdefghijklmnopqrstuvw";
+    for (int value = 0; value < 64; value++) {
+        if (ASCIItoBytes[static_cast<unsigned char>(alphabet[value])] != value) return false;
+    }
+    int validCnt = 0;
+    for (int c = 0; c < 256; c++) {
+        if (ASCIItoBytes[c] != SIXBIT_INVALID) validCnt++;
+    }
+    return validCnt == 64;
+}
+static_assert(checkASCIIToBytesTable(), "ASCIItoBytes table does not match AIVDM sixbit alphabet");
+
+//! Number of zeroed bytes following packed AIS message
+#define PACKED_PAYLOAD_PADDING 16
+//! Number of bytes of single slot AIS message (168 bits)
+#define AIS_SINGLE_SLOT_BYTES 21
+
+/**
+ *    \fn           constexpr size_t packedPayloadSize(size_t charCnt)
+ *    \brief        Returns size of byte array required for storing packed AIS message
+ *    \param[in]    charCnt
+ *                    Number of characters of AIS message string
+ *    \return       Size of byte array in bytes including padding
+ *    \note         Array is never shorter than single slot message, so that all fields of truncated
+ *                  position reports can be read
+ */
+constexpr size_t packedPayloadSize(size_t charCnt)
+{
+    return ((charCnt*6 + 7)/8 > AIS_SINGLE_SLOT_BYTES ? (charCnt*6 + 7)/8 : AIS_SINGLE_SLOT_BYTES) + PACKED_PAYLOAD_PADDING;
+}
 
 /**
- *    \fn           void convertAISMsgStringToBinaryFormat(string& msgString, byte* msgBin)
+ *    \fn           bool convertAISMsgStringToBinaryFormat(string_view msgString, byte* msgBin)
  *    \brief        Converts AIS message string into byte array
+ *    \details      6-bit values of subsequent characters are packed into a dense big-endian
+ *                  bit stream, i.e. bit 0 of the message is the most significant bit of msgBin[0].
  *    \param[in]    msgString
  *                    AIS message string
  *    \param[out]    msgBin
  *                    Pointer to byte array
- *    \warning      msgBin must point to already allocated memory
+ *    \return       Boolean value determining if all characters belong to the sixbit alphabet
+ *    \note         Uses AVX2 or SSSE3 instructions when available, scalar code otherwise
+ *    \warning      msgBin must point to already allocated memory of packedPayloadSize(msgString.length()) bytes
  */
-void convertAISMsgStringToBinaryFormat(string& msgString, byte* msgBin);
+bool convertAISMsgStringToBinaryFormat(string_view msgString, byte* msgBin);
 
 /**
- *    \fn           unsigned getFieldValue(byte* msg, byte idx, byte len)
+ *    \fn           unsigned getFieldValue(const byte* msg, unsigned idx, unsigned len)
  *    \brief        Extracts value from byte array given starting bit index and lenght of bit field
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \param[in]    idx
  *                    Index of the starting bit
  *    \param[in]    len
- *                    Length of bit fied
+ *                    Length of bit fied (1-32)
  *    \return       Value included in bit field
+ *    \warning      8 bytes starting at byte containing bit idx must be readable
+ */
+unsigned getFieldValue(const byte* msg, unsigned idx, unsigned len);
+/**
+ *    \fn           int getSignedFieldValue(const byte* msg, unsigned idx, unsigned len)
+ *    \brief        Extracts two's complement value from byte array given starting bit index and lenght of bit field
+ *    \param[in]    msg
+ *                    AIS message in binary format
+ *    \param[in]    idx
+ *                    Index of the starting bit
+ *    \param[in]    len
+ *                    Length of bit fied (1-32)
+ *    \return       Sign extended value included in bit field
+ *    \warning      8 bytes starting at byte containing bit idx must be readable
  */
-unsigned getFieldValue(byte* msg, byte idx, byte len);
+int getSignedFieldValue(const byte* msg, unsigned idx, unsigned len);
 
 /**
- *    \fn           unsigned extractMessageType(byte* msg)
+ *    \fn           unsigned extractMessageType(const byte* msg)
  *    \brief        Extracts value of parameter 'Message Type' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Message Type'
  */
-unsigned extractMessageType(byte* msg);
+unsigned extractMessageType(const byte* msg);
 /**
- *    \fn           unsigned extractRepeatIndicator(byte* msg)
+ *    \fn           unsigned extractRepeatIndicator(const byte* msg)
  *    \brief        Extracts value of parameter 'Repeat Indicator' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Repeat Indicator'
  */
-unsigned extractRepeatIndicator(byte* msg);
+unsigned extractRepeatIndicator(const byte* msg);
 /**
- *    \fn           unsigned extractMMSI(byte* msg)
+ *    \fn           unsigned extractMMSI(const byte* msg)
  *    \brief        Extracts value of parameter 'MMSI' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'MMSI'
  */
-unsigned extractMMSI(byte* msg);
+unsigned extractMMSI(const byte* msg);
 /**
- *    \fn           unsigned extractNavigationStatus(byte* msg)
+ *    \fn           unsigned extractNavigationStatus(const byte* msg)
  *    \brief        Extracts value of parameter 'Navigation Status' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Navigation Status'
  */
-unsigned extractNavigationStatus(byte* msg);
+unsigned extractNavigationStatus(const byte* msg);
 /**
- *    \fn           unsigned extractRateOfTurn(byte* msg)
+ *    \fn           int extractRateOfTurn(const byte* msg)
  *    \brief        Extracts value of parameter 'Rate Of Turn' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Rate Of Turn'
  */
-unsigned extractRateOfTurn(byte* msg);
+int extractRateOfTurn(const byte* msg);
 /**
- *    \fn           unsigned extractSpeedOverGround(byte* msg)
+ *    \fn           unsigned extractSpeedOverGround(const byte* msg)
  *    \brief        Extracts value of parameter 'Speed Over Ground' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Speed Over Ground'
  */
-unsigned extractSpeedOverGround(byte* msg);
+unsigned extractSpeedOverGround(const byte* msg);
 /**
- *    \fn           unsigned extractPositionAccuracy(byte* msg)
+ *    \fn           unsigned extractPositionAccuracy(const byte* msg)
  *    \brief        Extracts value of parameter 'Position Accuracy' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Position Accuracy'
  */
-unsigned extractPositionAccuracy(byte* msg);
+unsigned extractPositionAccuracy(const byte* msg);
 /**
- *    \fn           unsigned extractLongitude(byte* msg)
+ *    \fn           int extractLongitude(const byte* msg)
  *    \brief        Extracts value of parameter 'Longitude' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Longitude'
  */
-unsigned extractLongitude(byte* msg);
+int extractLongitude(const byte* msg);
 /**
- *    \fn           unsigned extractLatitude(byte* msg)
+ *    \fn           int extractLatitude(const byte* msg)
  *    \brief        Extracts value of parameter 'Latitude' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Latitude'
  */
-unsigned extractLatitude(byte* msg);
+int extractLatitude(const byte* msg);
 /**
- *    \fn           unsigned extractCourseOverGround(byte* msg)
+ *    \fn           unsigned extractCourseOverGround(const byte* msg)
  *    \brief        Extracts value of parameter 'Course Over Ground' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Course Over Ground'
  */
-unsigned extractCourseOverGround(byte* msg);
+unsigned extractCourseOverGround(const byte* msg);
 /**
- *    \fn           unsigned extractTrueHeading(byte* msg)
+ *    \fn           unsigned extractTrueHeading(const byte* msg)
  *    \brief        Extracts value of parameter 'True Heading' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'True Heading'
  */
-unsigned extractTrueHeading(byte* msg);
+unsigned extractTrueHeading(const byte* msg);
 /**
- *    \fn           unsigned extractTimeStamp(byte* msg)
+ *    \fn           unsigned extractTimeStamp(const byte* msg)
  *    \brief        Extracts value of parameter 'Time Stamp' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Time Stamp'
  */
-unsigned extractTimeStamp(byte* msg);
+unsigned extractTimeStamp(const byte* msg);
 /**
- *    \fn           unsigned extractManeuverIndicator(byte* msg)
+ *    \fn           unsigned extractManeuverIndicator(const byte* msg)
  *    \brief        Extracts value of parameter 'Maneuver Indicator' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Maneuver Indicator'
  */
-unsigned extractManeuverIndicator(byte* msg);
+unsigned extractManeuverIndicator(const byte* msg);
 /**
- *    \fn           unsigned extractRAIMFlag(byte* msg)
+ *    \fn           unsigned extractRAIMFlag(const byte* msg)
  *    \brief        Extracts value of parameter 'RAIM Flag' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'RAIM Flag'
  */
-unsigned extractRAIMFlag(byte* msg);
+unsigned extractRAIMFlag(const byte* msg);
 /**
- *    \fn           unsigned extractRadioStatus(byte* msg)
+ *    \fn           unsigned extractRadioStatus(const byte* msg)
  *    \brief        Extracts value of parameter 'Radio Status' from AIS message in binary format
  *    \param[in]    msg
  *                    AIS message in binary format
  *    \return       Value of parameter 'Radio Status'
  */
-unsigned extractRadioStatus(byte* msg);
+unsigned extractRadioStatus(const byte* msg);
 
 
 #endif /* extraction_hpp */
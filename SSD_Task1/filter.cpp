@@ -0,0 +1,204 @@
+/**
+ * \file filter.cpp
+ *
+ * \brief Selection of AIS messages before decoding.
+ *
+ * \details This file includes definitions of functions used for selecting AIS messages by type, sender and position before they are decoded.
+ *
+ * \date    16/10/2026
+ */
+
+#include <cstdlib>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include "filter.hpp"
+
+using std::string;
+using std::ifstream;
+using std::stringstream;
+
+/**
+ *    \fn           bool isListSeparator(char c)
+ *    \brief        Checks if character separates elements of a list
+ *    \param[in]    c
+ *                    Checked character
+ *    \return       Boolean value determining if character is a comma or whitespace
+ */
+static inline bool isListSeparator(char c)
+{
+    return c == ',' || c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ *    \fn           bool nextListNumber(const char*& text, unsigned long& number)
+ *    \brief        Converts next element of a list of unsigned numbers
+ *    \param[in,out] text
+ *                    Position in the list, moved past the converted element
+ *    \param[out]    number
+ *                    Converted number
+ *    \return       Boolean value determining if number was converted (false at the end of the list or on error)
+ */
+static bool nextListNumber(const char*& text, unsigned long& number)
+{
+    while (isListSeparator(*text)) text++;
+    if (*text < '0' || *text > '9') return false;
+    char* end = nullptr;
+    number = strtoul(text, &end, 10);
+    if (*end != '\0' && !isListSeparator(*end)) return false;
+    text = end;
+    return true;
+}
+
+/**
+ *    \fn           bool isListEnd(const char* text)
+ *    \brief        Checks if only separators are left in the list
+ *    \param[in]    text
+ *                    Position in the list
+ *    \return       Boolean value determining if list was converted completely
+ */
+static bool isListEnd(const char* text)
+{
+    while (isListSeparator(*text)) text++;
+    return *text == '\0';
+}
+
+MessageFilter::MessageFilter()
+: m_types(DEFAULT_FILTER_TYPES), m_hasMMSIList(false), m_MMSIs(16), m_hasBoundingBox(false),
+  m_minLongitude(0), m_minLatitude(0), m_maxLongitude(0), m_maxLatitude(0)
+{
+}
+
+/**
+ *    \fn           bool MessageFilter::setTypes(const char* list)
+ *    \brief        Selects message types
+ *    \param[in]    list
+ *                    Comma separated types, each of them 1, 2 or 3
+ *    \return       Boolean value determining if list is valid
+ */
+bool MessageFilter::setTypes(const char* list)
+{
+    // Only position reports have output format
+    uint32_t types = 0;
+    unsigned long type;
+    while (nextListNumber(list, type)) {
+        if (type < 1 || type > 3) return false;
+        types |= 1u << type;
+    }
+    if (!isListEnd(list) || types == 0) return false;
+    m_types = types;
+    return true;
+}
+
+/**
+ *    \fn           bool MessageFilter::setMMSIList(const char* list)
+ *    \brief        Selects senders
+ *    \param[in]    list
+ *                    Comma separated MMSI numbers or '@' followed by path of a file containing
+ *                    MMSI numbers separated by commas or whitespace
+ *    \return       Boolean value determining if list is valid and file could be read
+ */
+bool MessageFilter::setMMSIList(const char* list)
+{
+    string content;
+    if (list[0] == '@') {
+        ifstream list_file(list + 1);
+        if (!list_file.is_open()) return false;
+        stringstream buffer;
+        buffer << list_file.rdbuf();
+        content = buffer.str();
+        list = content.c_str();
+    }
+
+    // MMSI numbers have 30 bits
+    MMSIMap<char> MMSIs;
+    unsigned long MMSI;
+    bool inserted;
+    while (nextListNumber(list, MMSI)) {
+        if (MMSI >= (1ul << 30)) return false;
+        MMSIs.insert(static_cast<unsigned>(MMSI), inserted);
+    }
+    if (!isListEnd(list) || MMSIs.size() == 0) return false;
+    m_MMSIs = std::move(MMSIs);
+    m_hasMMSIList = true;
+    return true;
+}
+
+/**
+ *    \fn           bool MessageFilter::setBoundingBox(const char* box)
+ *    \brief        Selects area of positions
+ *    \param[in]    box
+ *                    Comma separated minimal longitude, minimal latitude, maximal longitude
+ *                    and maximal latitude in degrees
+ *    \return       Boolean value determining if area is valid
+ *    \note         Area crossing the antimeridian is given with minimal longitude greater than maximal one
+ */
+bool MessageFilter::setBoundingBox(const char* box)
+{
+    double corners[4];
+    for (int i = 0; i < 4; i++) {
+        char* end = nullptr;
+        corners[i] = strtod(box, &end);
+        if (end == box || *end != (i < 3 ? ',' : '\0') || !std::isfinite(corners[i])) return false;
+        box = end + 1;
+    }
+    if (corners[0] < -180 || corners[0] > 180 || corners[2] < -180 || corners[2] > 180 ||
+        corners[1] < -90 || corners[3] > 90 || corners[1] > corners[3]) {
+        return false;
+    }
+
+    // Compare raw values, positions are given in 1/10000 min
+    m_minLongitude = static_cast<int>(std::lround(corners[0] * 600000));
+    m_minLatitude = static_cast<int>(std::lround(corners[1] * 600000));
+    m_maxLongitude = static_cast<int>(std::lround(corners[2] * 600000));
+    m_maxLatitude = static_cast<int>(std::lround(corners[3] * 600000));
+    m_hasBoundingBox = true;
+    return true;
+}
+
+/**
+ *    \fn           FilterResult MessageFilter::check(string_view payload) const
+ *    \brief        Checks message against all predicates
+ *    \param[in]    payload
+ *                    Payload of AIS message
+ *    \return       Result of the check
+ */
+FilterResult MessageFilter::check(string_view payload) const
+{
+    // Type needs only the first character
+    unsigned type;
+    if (!extractArmored<CommonHeaderSchema::MessageType>(payload, type)) return FILTER_UNREADABLE;
+    if (type >= 32 || (m_types & (1u << type)) == 0) return FILTER_REJECTED;
+
+    // MMSI needs characters 1-6
+    if (m_hasMMSIList) {
+        unsigned MMSI;
+        if (payload.size() < armoredLength<CommonHeaderSchema::MMSI>()) return FILTER_REJECTED;
+        if (!extractArmored<CommonHeaderSchema::MMSI>(payload, MMSI)) return FILTER_UNREADABLE;
+        if (m_MMSIs.find(MMSI) == MMSI_MAP_NOT_FOUND) return FILTER_REJECTED;
+    }
+
+    // Position needs characters 10-19
+    if (m_hasBoundingBox) {
+        int longitude, latitude;
+        if (payload.size() < armoredLength<PositionReportSchema::Latitude>()) return FILTER_REJECTED;
+        if (!extractArmored<PositionReportSchema::Longitude>(payload, longitude) ||
+            !extractArmored<PositionReportSchema::Latitude>(payload, latitude)) {
+            return FILTER_UNREADABLE;
+        }
+        if (latitude < m_minLatitude || latitude > m_maxLatitude) return FILTER_REJECTED;
+        if (m_minLongitude <= m_maxLongitude) {
+            if (longitude < m_minLongitude || longitude > m_maxLongitude) return FILTER_REJECTED;
+        }
+        else {
+            // Area crosses the antimeridian, longitude 181 means 'not available'
+            if (longitude < -FILTER_MAX_LONGITUDE || longitude > FILTER_MAX_LONGITUDE ||
+                (longitude < m_minLongitude && longitude > m_maxLongitude)) {
+                return FILTER_REJECTED;
+            }
+        }
+    }
+    return FILTER_ACCEPTED;
+}
@@ -0,0 +1,147 @@
+/**
+ * \file filter.hpp
+ *
+ * \brief Header file of 'filter.cpp'.
+ *
+ * \details This file includes declarations of structures and functions used for selecting AIS messages by type, sender and position before they are decoded.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef filter_hpp
+#define filter_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "main.hpp"
+#include "extraction.hpp"
+#include "schema.hpp"
+#include "registry.hpp"
+
+using std::string_view;
+
+//! Message types selected when no type filter is given
+#define DEFAULT_FILTER_TYPES ((1u << 1) | (1u << 3))
+//! Raw value of longitude of 180 degrees (1/10000 min)
+#define FILTER_MAX_LONGITUDE 108000000
+
+/**
+ *    \fn           constexpr size_t armoredLength()
+ *    \brief        Returns number of payload characters needed to hold the field
+ *    \tparam       F
+ *                    Field of the schema
+ */
+template <class F>
+constexpr size_t armoredLength()
+{
+    return (F::offset + F::length - 1) / 6 + 1;
+}
+
+/**
+ *    \fn           bool extractArmored(string_view payload, typename F::value_type& value)
+ *    \brief        Extracts raw value of the field directly from armored payload characters
+ *    \details      Only characters holding bits of the field are converted, so checking a field
+ *                  near the beginning of the message does not cost conversion of the whole payload.
+ *    \param[in]    payload
+ *                    Payload of AIS message (6 bits per character)
+ *    \param[out]    value
+ *                    Raw value of the field
+ *    \return       Boolean value determining if payload contains valid characters holding the field
+ *    \tparam       F
+ *                    Field of the schema, spanning at most 10 characters
+ */
+template <class F>
+bool extractArmored(string_view payload, typename F::value_type& value)
+{
+    constexpr unsigned firstChar = F::offset / 6;
+    constexpr unsigned lastChar = armoredLength<F>() - 1;
+    static_assert(lastChar - firstChar < 10, "Field must span at most 10 payload characters");
+    if (payload.size() <= lastChar) return false;
+
+    // Collect characters in the most significant bits of the word, as if it was loaded from binary message
+    uint64_t word = 0;
+    for (unsigned i = firstChar; i <= lastChar; i++) {
+        byte sixbit = ASCIItoBytes[static_cast<unsigned char>(payload[i])];
+        if (sixbit == SIXBIT_INVALID) return false;
+        word |= static_cast<uint64_t>(sixbit) << (58 - 6*(i - firstChar));
+    }
+    value = F::fromWord(word, firstChar*6);
+    return true;
+}
+
+/**
+ *    \enum         FilterResult
+ *    \brief        Result of checking message against the filter
+ */
+enum FilterResult {
+    FILTER_ACCEPTED = 0,    /*!< Message matches all predicates */
+    FILTER_REJECTED,        /*!< Message does not match some predicate */
+    FILTER_UNREADABLE       /*!< Payload contains characters outside the sixbit alphabet */
+};
+
+/**
+ *    \class        MessageFilter
+ *    \brief        Predicates selecting messages by type, MMSI number and position
+ *    \details      Predicates are checked on armored payload, converting only characters holding
+ *                  the checked fields. Type is checked first, as it needs only a single character.
+ *                  Position is only checked for position reports (types 1, 2 and 3).
+ */
+class MessageFilter {
+public:
+    MessageFilter();
+
+    /**
+     *    \fn           bool setTypes(const char* list)
+     *    \brief        Selects message types
+     *    \param[in]    list
+     *                    Comma separated types, each of them 1, 2 or 3
+     *    \return       Boolean value determining if list is valid
+     */
+    bool setTypes(const char* list);
+    /**
+     *    \fn           bool setMMSIList(const char* list)
+     *    \brief        Selects senders
+     *    \param[in]    list
+     *                    Comma separated MMSI numbers or '@' followed by path of a file containing
+     *                    MMSI numbers separated by commas or whitespace
+     *    \return       Boolean value determining if list is valid and file could be read
+     */
+    bool setMMSIList(const char* list);
+    /**
+     *    \fn           bool setBoundingBox(const char* box)
+     *    \brief        Selects area of positions
+     *    \param[in]    box
+     *                    Comma separated minimal longitude, minimal latitude, maximal longitude
+     *                    and maximal latitude in degrees
+     *    \return       Boolean value determining if area is valid
+     *    \note         Area crossing the antimeridian is given with minimal longitude greater than maximal one
+     */
+    bool setBoundingBox(const char* box);
+
+    /**
+     *    \fn           FilterResult check(string_view payload) const
+     *    \brief        Checks message against all predicates
+     *    \param[in]    payload
+     *                    Payload of AIS message
+     *    \return       Result of the check
+     */
+    FilterResult check(string_view payload) const;
+    /**
+     *    \fn           uint32_t types() const
+     *    \brief        Returns bit mask of selected message types (bit n selects type n)
+     */
+    uint32_t types() const { return m_types; }
+
+private:
+    uint32_t m_types;           /*!< Bit mask of selected message types */
+    bool m_hasMMSIList;         /*!< Determines if senders are selected */
+    MMSIMap<char> m_MMSIs;      /*!< Selected senders */
+    bool m_hasBoundingBox;      /*!< Determines if area is selected */
+    int m_minLongitude;         /*!< Minimal longitude in 1/10000 min */
+    int m_minLatitude;          /*!< Minimal latitude in 1/10000 min */
+    int m_maxLongitude;         /*!< Maximal longitude in 1/10000 min */
+    int m_maxLatitude;          /*!< Maximal latitude in 1/10000 min */
+};
+
+#endif /* filter_hpp */
@@ -0,0 +1,93 @@
+/**
+ * \file format.hpp
+ *
+ * \brief Formatting of output records.
+ *
+ * \details This file includes definition of character cursor used for assembling output content without temporary strings.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef format_hpp
+#define format_hpp
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+
+using std::string_view;
+
+/**
+ *    \class        RecordBuffer
+ *    \brief        Cursor assembling a single output record in memory provided by the caller
+ *    \details      Memory must be large enough for the whole record, so appending does not check
+ *                  bounds. Storage is usually taken from the scratch arena of the calling thread.
+ */
+class RecordBuffer {
+public:
+    /**
+     *    \fn           RecordBuffer(char* storage)
+     *    \brief        Creates empty record
+     *    \param[in]    storage
+     *                    Memory sufficient for the whole record
+     */
+    explicit RecordBuffer(char* storage) : m_begin(storage), m_pos(storage) {}
+
+    /**
+     *    \fn           RecordBuffer& append(string_view text)
+     *    \brief        Appends text to the record
+     *    \param[in]    text
+     *                    Appended text
+     *    \return       Reference to the buffer
+     */
+    RecordBuffer& append(string_view text)
+    {
+        memcpy(m_pos, text.data(), text.size());
+        m_pos += text.size();
+        return *this;
+    }
+
+    /**
+     *    \fn           RecordBuffer& append(const char (&text)[N])
+     *    \brief        Appends string literal to the record, its length is known at compile time
+     *    \param[in]    text
+     *                    Appended literal
+     *    \return       Reference to the buffer
+     */
+    template <size_t N>
+    RecordBuffer& append(const char (&text)[N])
+    {
+        memcpy(m_pos, text, N - 1);
+        m_pos += N - 1;
+        return *this;
+    }
+
+    /**
+     *    \fn           RecordBuffer& appendUnsigned(unsigned value)
+     *    \brief        Appends decimal representation of the number to the record
+     *    \param[in]    value
+     *                    Appended number
+     *    \return       Reference to the buffer
+     */
+    RecordBuffer& appendUnsigned(unsigned value)
+    {
+        char digits[10];
+        int digitCnt = 0;
+        do {
+            digits[digitCnt++] = static_cast<char>('0' + value % 10);
+            value /= 10;
+        } while (value > 0);
+        while (digitCnt > 0) *m_pos++ = digits[--digitCnt];
+        return *this;
+    }
+
+    char* end() { return m_pos; }                                                       /*!< Returns position of the next character */
+    void advance(char* end) { m_pos = end; }                                            /*!< Moves position after characters written directly */
+    string_view view() const { return string_view(m_begin, m_pos - m_begin); }        /*!< Returns view of the record */
+
+private:
+    char* m_begin;      /*!< Beginning of the record */
+    char* m_pos;        /*!< Position of the next character */
+};
+
+#endif /* format_hpp */
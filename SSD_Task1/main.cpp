@@ -11,41 +11,567 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
+#include <climits>
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
 
 #include "main.hpp"
 #include "read.hpp"
+#include "scan.hpp"
 #include "extraction.hpp"
+#include "report.hpp"
 #include "decoding.hpp"
+#include "ring.hpp"
 #include "write.hpp"
+#include "pipeline.hpp"
+#include "format.hpp"
+#include "reassembly.hpp"
+#include "filter.hpp"
+#include "view.hpp"
+#include "arena.hpp"
 
-using namespace std;
+using std::string;
+using std::ifstream;
+using std::vector;
+using std::deque;
+using std::unique_ptr;
+using std::thread;
+using std::cout;
+using std::cin;
+using std::endl;
+
+//! Upper bound of the length of output record without date and time
+#define POSITION_RECORD_MAX_SIZE 512
+//! Upper bound of the length of date and time of a decoded line together
+#define DATE_TIME_MAX_SIZE 64
+//! Upper bound of the length of output record
+#define OUTPUT_RECORD_MAX_SIZE (DATE_TIME_MAX_SIZE + POSITION_RECORD_MAX_SIZE)
+
+/**
+ *    \fn           string_view decodeAISMsg(string_view date, string_view time, const PositionReport& report, uint32_t fields, ScratchArena& arena)
+ *    \brief        Creates output content that can be written to file
+ *    \param[in]    date
+ *                    Date of the message
+ *    \param[in]    time
+ *                    Time of the message
+ *    \param[in]    report
+ *                    Decoded position report
+ *    \param[in]    fields
+ *                    Mask of ReportField bits selecting written fields
+ *    \param[in]    arena
+ *                    Arena providing memory for the content
+ *    \return       View of the output content valid until the arena is reset
+ */
+string_view decodeAISMsg(string_view date, string_view time, const PositionReport& report, uint32_t fields, ScratchArena& arena)
+{
+    const RenderTables& tables = getRenderTables();
+    RecordBuffer record(arena.allocate<char>(date.size() + time.size() + POSITION_RECORD_MAX_SIZE));
+    
+    // Every field occupies its own line, so that any of them can be left out
+    if (fields & REPORT_FIELD_TIME) record.append(date).append(" ").append(time).append("\n");
+    if (fields & REPORT_FIELD_TYPE) record.append("Message type: ").append(tables.messageType[report.messageType & 0x3F]).append("\n");
+    if (fields & REPORT_FIELD_COUNT) record.append("\tCount: ").appendUnsigned(report.repeatIndicator).append("\n");
+    if (fields & REPORT_FIELD_MMSI) record.append("\tMMSI: ").appendUnsigned(report.MMSI).append("\n");
+    if (fields & REPORT_FIELD_STATUS) record.append("\tStatus: ").append(tables.navigationStatus[report.status & 0x0F].view()).append("\n");
+    if (fields & REPORT_FIELD_ROT) record.append("\tROT: ").append(tables.rateOfTurn[static_cast<byte>(report.rateOfTurn)].view()).append("\n");
+    if (fields & REPORT_FIELD_SOG) record.append("\tSOG: ").append(tables.speedOverGround[report.speedOverGround & 0x3FF].view()).append("\n");
+    if (fields & REPORT_FIELD_ACCURACY) record.append("\tAccuracy: ").append(tables.positionAccuracy[report.positionAccuracy & 0x01].view()).append("\n");
+    if (fields & REPORT_FIELD_LON) {
+        record.append("\tLON: ");
+        record.advance(writeLongitude(report.longitude, record.end()));
+        record.append("\n");
+    }
+    if (fields & REPORT_FIELD_LAT) {
+        record.append("\tLAT: ");
+        record.advance(writeLatitude(report.latitude, record.end()));
+        record.append("\n");
+    }
+    if (fields & REPORT_FIELD_COG) record.append("\tCOG: ").append(tables.courseOverGround[report.courseOverGround & 0xFFF].view()).append("\n");
+    if (fields & REPORT_FIELD_HDG) record.append("\tHDG: ").append(tables.trueHeading[report.trueHeading & 0x1FF].view()).append("\n");
+    if (fields & REPORT_FIELD_TIMESTAMP) record.append("\tTimestamp: ").append(tables.timeStamp[report.timeStamp & 0x3F].view()).append("\n");
+    if (fields & REPORT_FIELD_MANEUVER) record.append("\tManeuver: ").append(tables.maneuverIndicator[report.maneuver & 0x03].view()).append("\n");
+    record.append("\n");
+    
+    return record.view();
+}
+
+/**
+ *    \fn           bool parseUnsignedOption(const char* text, unsigned& value)
+ *    \brief        Converts value of command line option to unsigned number
+ *    \param[in]    text
+ *                    Value of the option
+ *    \param[out]    value
+ *                    Converted number
+ *    \return       Boolean value determining if conversion was successful
+ */
+bool parseUnsignedOption(const char* text, unsigned& value)
+{
+    char* end = nullptr;
+    unsigned long number = strtoul(text, &end, 10);
+    if (end == text || *end != '\0' || text[0] == '-' || number > UINT_MAX) return false;
+    value = static_cast<unsigned>(number);
+    return true;
+}
+
+/**
+ *    \struct       DecoderStats
+ *    \brief        Structure for storing counts of lines skipped by a decoding thread
+ */
+struct DecoderStats {
+    unsigned malformedCnt = 0;      /*!< Number of lines that could not be decoded */
+    unsigned checksumErrCnt = 0;    /*!< Number of lines with invalid checksum */
+    unsigned incompleteCnt = 0;     /*!< Number of multi-sentence messages missing some of their sentences */
+};
+
+/**
+ *    \struct       ProcessingOptions
+ *    \brief        Structure for storing options of processing given in the command line
+ */
+struct ProcessingOptions {
+    unsigned maxOpenFiles = DEFAULT_MAX_OPEN_FILES;                     /*!< Number of output files kept open at once */
+    unsigned writeBufferMB = DEFAULT_WRITE_BUFFER_BUDGET/(1024*1024);   /*!< Memory for buffered output in MB */
+    unsigned ringSizeKB = DEFAULT_RING_CAPACITY/1024;                   /*!< Capacity of queues feeding each writer thread in kB */
+    unsigned threadCnt = 1;                                             /*!< Number of decoder threads */
+    unsigned writerCnt = 0;                                             /*!< Number of writer threads (0 selects default) */
+    unsigned chunkThreadCnt = 0;                                        /*!< Number of threads processing parts of the file (0 disables) */
+    MessageFilter filter;                                               /*!< Selection of written messages */
+    uint32_t fields = REPORT_FIELDS_ALL;                                /*!< Mask of ReportField bits selecting written fields */
+};
+
+/**
+ *    \struct       ProcessingStats
+ *    \brief        Structure for storing statistics of processing of the whole file
+ */
+struct ProcessingStats {
+    DecoderStats lines;                 /*!< Counts of skipped lines */
+    uint64_t fullStalls = 0;            /*!< Number of waits of decoder threads for writer threads */
+    uint64_t emptyStalls = 0;           /*!< Number of waits of writer threads for decoder threads */
+    size_t stolenChunkCnt = 0;          /*!< Number of parts of the file processed by idle threads */
+    size_t maxWaitingChunkCnt = 0;      /*!< Highest number of processed parts waiting for being written */
+};
+
+/**
+ *    \enum         LineCheck
+ *    \brief        Result of checking line before its decoding
+ */
+enum LineCheck {
+    LINE_VALID = 0,         /*!< Line can be decoded */
+    LINE_CHECKSUM_ERROR,    /*!< Checksum of the sentence is invalid */
+    LINE_MALFORMED          /*!< Line could not be split into elements of AIS message or is too long */
+};
+
+/**
+ *    \fn           LineCheck checkLine(const lineView& line)
+ *    \brief        Checks if line can be decoded
+ *    \param[in]    line
+ *                    Line read from the input file
+ *    \return       Result of the check
+ */
+LineCheck checkLine(const lineView& line)
+{
+    // Skip corrupted lines before paying for their decoding
+    if (!validateNMEAChecksum(line.sentence)) return LINE_CHECKSUM_ERROR;
+    
+    // Skip lines that could not be split into elements of AIS message or would not fit into output record
+    if (line.AISMsgStatus != AIS_PARSE_OK || line.date.size() + line.time.size() > DATE_TIME_MAX_SIZE) return LINE_MALFORMED;
+    return LINE_VALID;
+}
+
+/**
+ *    \fn           void restoreFragment(const lineView& line, size_t lineNum, FragmentReassembler& reassembler)
+ *    \brief        Passes sentence preceding the decoded lines to the reassembly table without decoding it
+ *    \param[in]    line
+ *                    Line read from the input file
+ *    \param[in]    lineNum
+ *                    Number of the line in the input file or its part
+ *    \param[in,out] reassembler
+ *                    Table joining sentences of multi-sentence messages
+ *    \note         Line is checked as by decodeLine(), so that the table receives the same sentences
+ *                  however the file is split
+ */
+void restoreFragment(const lineView& line, size_t lineNum, FragmentReassembler& reassembler)
+{
+    if (line.AISMsgStatus != AIS_PARSE_OK || !isMultipart(line.AISMsg) || checkLine(line) != LINE_VALID) return;
+    string_view payload;
+    reassembler.add(line.AISMsg, lineNum, payload);
+}
+
+/**
+ *    \fn           bool decodeLine(const lineView& line, size_t lineNum, string_view& content, unsigned& MMSI, DecoderStats& stats, const ProcessingOptions& options, FragmentReassembler& reassembler, ScratchArena& arena)
+ *    \brief        Decodes single line and creates its output content
+ *    \param[in]    line
+ *                    Line read from the input file
+ *    \param[in]    lineNum
+ *                    Number of the line in the input file or its part
+ *    \param[out]    content
+ *                    Output content of the line (valid until the arena is reset)
+ *    \param[out]    MMSI
+ *                    MMSI number of sender (name of the file to be written to)
+ *    \param[in,out] stats
+ *                    Counts of skipped lines
+ *    \param[in]    options
+ *                    Options of processing selecting written messages and fields
+ *    \param[in,out] reassembler
+ *                    Table joining sentences of multi-sentence messages
+ *    \param[in]    arena
+ *                    Arena providing scratch memory
+ *    \return       Boolean value determining if line produced any output
+ *    \note         Sentence of a multi-sentence message produces output only when it completes the message
+ */
+bool decodeLine(const lineView& line, size_t lineNum, string_view& content, unsigned& MMSI, DecoderStats& stats, const ProcessingOptions& options, FragmentReassembler& reassembler, ScratchArena& arena)
+{
+    LineCheck check = checkLine(line);
+    if (check == LINE_CHECKSUM_ERROR) {
+        stats.checksumErrCnt++;
+        return false;
+    }
+    if (check == LINE_MALFORMED) {
+        stats.malformedCnt++;
+        return false;
+    }
+    
+    // Join payloads of messages split into several sentences, decode them after the last one
+    string_view payload = line.AISMsg.payload;
+    if (isMultipart(line.AISMsg)) {
+        FragmentStatus status = reassembler.add(line.AISMsg, lineNum, payload);
+        if (status == FRAGMENT_INVALID) stats.malformedCnt++;
+        if (status != FRAGMENT_COMPLETE) return false;
+    }
+    
+    // Skip messages not selected by the user, checking only the characters holding filtered fields
+    FilterResult selection = options.filter.check(payload);
+    if (selection == FILTER_REJECTED) return false;
+    if (selection == FILTER_UNREADABLE) {
+        stats.malformedCnt++;
+        return false;
+    }
+    
+    // Convert message to binary format
+    AISPayloadView msg;
+    if (!makePayloadView(payload, arena, msg)) {
+        stats.malformedCnt++;
+        return false;
+    }
+    
+    // Output file is chosen by MMSI alone, read directly from the view
+    MMSI = msg.mmsi();
+    
+    // Decode numeric content of the message, filter lets through position reports only
+    // (fields left out by the projection stay zero)
+    PositionReport report{};
+    decodePositionReport(msg.data(), report, options.fields);
+    
+    // Define output content
+    content = decodeAISMsg(line.date, line.time, report, options.fields, arena);
+    
+    // Print out content of each write
+    //cout << content;
+    
+    return true;
+}
+
+/**
+ *    \fn           void processBatch(const LineBatch& batch, const vector<RecordRing*>& rings, DecoderStats& stats, const ProcessingOptions& options, FragmentReassembler& reassembler, ScratchArena& arena)
+ *    \brief        Decodes batch of lines and passes output content to the writer threads
+ *    \param[in]    batch
+ *                    Batch of lines read from the input file
+ *    \param[in]    rings
+ *                    Rings feeding writer threads, one per writer thread
+ *    \param[in,out] stats
+ *                    Counts of skipped lines
+ *    \param[in]    options
+ *                    Options of processing selecting written messages and fields
+ *    \param[in,out] reassembler
+ *                    Table joining sentences of multi-sentence messages, restored from the context of the batch
+ *    \param[in]    arena
+ *                    Arena providing scratch memory, reset before decoding the batch
+ *    \note         Every ring receives RING_TAG_BATCH_END record after the content of the batch
+ */
+void processBatch(const LineBatch& batch, const vector<RecordRing*>& rings, DecoderStats& stats, const ProcessingOptions& options, FragmentReassembler& reassembler, ScratchArena& arena)
+{
+    arena.reset();
+    
+    // Messages left unfinished by earlier batches are restored from their sentences, the one
+    // completing a message outputs it
+    reassembler.reset(batch.firstLine);
+    for (const NumberedLine& fragment : batch.context) restoreFragment(fragment.line, fragment.num, reassembler);
+    string_view content;
+    unsigned MMSI;
+    unsigned shardCnt = static_cast<unsigned>(rings.size());
+    for (size_t lineIdx = 0; lineIdx < batch.lines.size(); lineIdx++) {
+        if (!decodeLine(batch.lines[lineIdx], batch.firstLine + lineIdx, content, MMSI, stats, options, reassembler, arena)) continue;
+        
+        // Pass message info to the writer thread owning the vessel's file
+        if (!rings[shardOfMMSI(MMSI, shardCnt)]->push(MMSI, content.data(), content.size())) {
+            cout << endl << "(WARNING) Output record does not fit into writer queue, MMSI: " << MMSI;
+        }
+    }
+    reassembler.finish(batch.firstLine + batch.lines.size(), batch.last);
+    
+    // Let writer threads move on to the next batch
+    for (RecordRing* ring : rings) ring->push(RING_TAG_BATCH_END, nullptr, 0);
+}
+
+/**
+ *    \fn           size_t windowStart(const MappedFileReader& file_reader, size_t offset, size_t& lineCnt)
+ *    \brief        Finds beginning of the lines preceding a part of the input file which may hold sentences of its unfinished messages
+ *    \param[in]    file_reader
+ *                    Reader of the input file
+ *    \param[in]    offset
+ *                    Offset of the beginning of the part
+ *    \param[out]    lineCnt
+ *                    Number of lines between the found beginning and the part
+ *    \return       Offset of the beginning of at least REASSEMBLY_WINDOW_LINES lines preceding the part or of the file
+ */
+size_t windowStart(const MappedFileReader& file_reader, size_t offset, size_t& lineCnt)
+{
+    MappedFileReader window_reader;
+    lineView line;
+    
+    // Readers skip empty lines, so go further back until enough lines are read
+    for (size_t physicalCnt = REASSEMBLY_WINDOW_LINES; ; physicalCnt *= 2) {
+        size_t start = file_reader.lineStartBefore(offset, physicalCnt);
+        window_reader.openRange(file_reader, start, offset);
+        lineCnt = 0;
+        while (readLineFromFile(line, window_reader)) lineCnt++;
+        if (lineCnt >= REASSEMBLY_WINDOW_LINES || start == 0) return start;
+    }
+}
 
 /**
- *    \fn           string decodeAISMsg(byte* AISMsg)
- *    \brief        Creates output string that can be written to file
- *    \param[in]    AISMsg
- *                    Pointer to byte array containing AIS message in binary format
- *    \return       Output string
+ *    \fn           void processChunk(const MappedFileReader& file_reader, size_t begin, size_t end, bool last, ChunkOutput& output, DecoderStats& stats, const ProcessingOptions& options, FragmentReassembler& reassembler, ScratchArena& arena)
+ *    \brief        Decodes all lines of a part of the input file and collects their output content
+ *    \param[in]    file_reader
+ *                    Reader of the input file
+ *    \param[in]    begin
+ *                    Offset of the beginning of the part
+ *    \param[in]    end
+ *                    Offset of the end of the part
+ *    \param[in]    last
+ *                    Determines if the part ends the input file
+ *    \param[out]    output
+ *                    Output content of the part indexed by MMSI number
+ *    \param[in,out] stats
+ *                    Counts of skipped lines
+ *    \param[in]    options
+ *                    Options of processing selecting written messages and fields
+ *    \param[in,out] reassembler
+ *                    Table joining sentences of multi-sentence messages, restored from the lines preceding the part
+ *    \param[in]    arena
+ *                    Arena providing scratch memory, reset every PIPELINE_BATCH_LINES lines
+ *    \note         Message is output by the part holding the sentence which completes it, so that
+ *                  the outputs do not depend on the number of parts
  */
-string decodeAISMsg(byte* AISMsg)
+void processChunk(const MappedFileReader& file_reader, size_t begin, size_t end, bool last, ChunkOutput& output, DecoderStats& stats, const ProcessingOptions& options, FragmentReassembler& reassembler, ScratchArena& arena)
 {
-    string line =
-    "Message type: " + getMessageType(extractMessageType(AISMsg)) +
-    "\n\tCount: " + getRepeatIndicator(extractRepeatIndicator(AISMsg)) +
-    "\n\tMMSI: " + getMMSI(extractMMSI(AISMsg)) +
-    "\n\tStatus: " + getNavigationStatus(extractNavigationStatus(AISMsg)) +
-    "\n\tROT: " + getRateOfTurn(extractRateOfTurn(AISMsg)) +
-    "\n\tSOG: " + getSpeedOverGround(extractSpeedOverGround(AISMsg)) +
-    "\n\tAccuracy: " + getPositionAccuracy(extractPositionAccuracy(AISMsg)) +
-    "\n\tLON: " + getLongitude(extractLongitude(AISMsg)) +
-    "\n\tLAT: " + getLatitude(extractLatitude(AISMsg)) +
-    "\n\tCOG: " + getCourseOverGround(extractCourseOverGround(AISMsg)) +
-    "\n\tHDG: " + getTrueHeading(extractTrueHeading(AISMsg)) +
-    "\n\tTimestamp: " + getTimeStamp(extractTimeStamp(AISMsg)) +
-    "\n\tManeuver: " + getManeuverIndicator(extractManeuverIndicator(AISMsg)) +
-    "\n";
-    
-    return line;
+    MappedFileReader chunk_reader;
+    lineView line;
+    string_view content;
+    unsigned MMSI;
+    bool inserted;
+    
+    // Lines preceding the part restore messages left unfinished by the previous part
+    size_t lineCnt = 0;
+    size_t windowLineCnt;
+    chunk_reader.openRange(file_reader, windowStart(file_reader, begin, windowLineCnt), begin);
+    reassembler.reset(windowLineCnt);
+    while (readLineFromFile(line, chunk_reader)) restoreFragment(line, lineCnt++, reassembler);
+    
+    chunk_reader.openRange(file_reader, begin, end);
+    while (readLineFromFile(line, chunk_reader)) {
+        if ((lineCnt - windowLineCnt) % PIPELINE_BATCH_LINES == 0) arena.reset();
+        if (decodeLine(line, lineCnt, content, MMSI, stats, options, reassembler, arena)) output[output.insert(MMSI, inserted)] += content;
+        lineCnt++;
+    }
+    reassembler.finish(lineCnt, last);
+}
+
+/**
+ *    \fn           bool processStreaming(MappedFileReader& file_reader, const string& outputDirPath, const ProcessingOptions& options, ProcessingStats& total)
+ *    \brief        Processes input file read by the calling thread, decoded and written by worker threads
+ *    \param[in]    file_reader
+ *                    Reader of the input file
+ *    \param[in]    outputDirPath
+ *                    Path of the output directory
+ *    \param[in]    options
+ *                    Options of processing
+ *    \param[out]    total
+ *                    Statistics of processing
+ *    \return       Boolean value determining if all output files were written successfully
+ *    \note         Lines are passed to decoder threads in batches, output records are routed to
+ *                  writer threads by MMSI number and written in the order of the input file.
+ */
+bool processStreaming(MappedFileReader& file_reader, const string& outputDirPath, const ProcessingOptions& options, ProcessingStats& total)
+{
+    unsigned threadCnt = options.threadCnt;
+    unsigned writerCnt = (options.writerCnt > 0) ? options.writerCnt : (threadCnt + 3) / 4;
+    vector<unique_ptr<VesselFileWriter>> file_writers;
+    for (unsigned shard = 0; shard < writerCnt; shard++) {
+        file_writers.emplace_back(new VesselFileWriter(outputDirPath, std::max(options.maxOpenFiles/writerCnt, 1u), DEFAULT_VESSEL_FLUSH_THRESHOLD,
+                                                       static_cast<size_t>(options.writeBufferMB)*1024*1024/writerCnt));
+    }
+    
+    // Create ring for every pair of decoder and writer thread (ring of pair (w, s) has index w*writerCnt+s)
+    size_t ringCapacity = static_cast<size_t>(options.ringSizeKB)*1024/threadCnt;
+    vector<unique_ptr<RecordRing>> write_rings;
+    for (unsigned ring = 0; ring < threadCnt*writerCnt; ring++) write_rings.emplace_back(new RecordRing(ringCapacity));
+    
+    // Start writer threads, each owning output files of a part of vessels
+    vector<char> writeSuccess(writerCnt, 1);
+    vector<thread> writer_threads;
+    for (unsigned shard = 0; shard < writerCnt; shard++) {
+        vector<RecordRing*> rings;
+        for (unsigned worker = 0; worker < threadCnt; worker++) rings.push_back(write_rings[worker*writerCnt + shard].get());
+        writer_threads.emplace_back([rings, shard, &file_writers, &writeSuccess]() {
+            writeSuccess[shard] = writeOrderedRecords(rings, *file_writers[shard]);
+        });
+    }
+    
+    // Start decoder threads, batches are assigned to them in turns
+    vector<unique_ptr<BatchQueue>> batch_queues;
+    vector<DecoderStats> stats(threadCnt);
+    vector<thread> decoder_threads;
+    for (unsigned worker = 0; worker < threadCnt; worker++) batch_queues.emplace_back(new BatchQueue());
+    for (unsigned worker = 0; worker < threadCnt; worker++) {
+        vector<RecordRing*> rings;
+        for (unsigned shard = 0; shard < writerCnt; shard++) rings.push_back(write_rings[worker*writerCnt + shard].get());
+        decoder_threads.emplace_back([rings, worker, &options, &batch_queues, &stats]() {
+            LineBatch batch;
+            DecoderStats workerStats;
+            FragmentReassembler reassembler(options.filter.types());
+            ScratchArena arena;
+            while (batch_queues[worker]->pop(batch)) processBatch(batch, rings, workerStats, options, reassembler, arena);
+            for (RecordRing* ring : rings) ring->close();
+            workerStats.incompleteCnt += static_cast<unsigned>(reassembler.droppedCnt());
+            stats[worker] = workerStats;
+        });
+    }
+    
+    // Read input file line by line, keeping multi-sentence lines which may continue in the next batch
+    lineView line;
+    LineBatch batch;
+    deque<NumberedLine> fragments;
+    size_t batchCnt = 0;
+    size_t lineCnt = 0;
+    while (readLineFromFile(line,file_reader)) {
+        
+        // Inform user about the progress
+        if(lineCnt%1000 == 0) cout << ".";
+        
+        // Pass full batch to the next decoder thread once it is known not to be the last one
+        if (batch.lines.size() == PIPELINE_BATCH_LINES) {
+            batch.seq = batchCnt;
+            batch_queues[batchCnt % threadCnt]->push(batch);
+            batchCnt++;
+        }
+        
+        // New batch starts with sentences of messages which may be unfinished
+        if (batch.lines.empty()) {
+            while (!fragments.empty() && fragments.front().num + REASSEMBLY_WINDOW_LINES < lineCnt) fragments.pop_front();
+            batch.firstLine = lineCnt;
+            batch.context.assign(fragments.begin(), fragments.end());
+        }
+        batch.lines.push_back(line);
+        if (line.AISMsgStatus == AIS_PARSE_OK && isMultipart(line.AISMsg)) fragments.push_back({lineCnt, line});
+        lineCnt++;
+    }
+    if (!batch.lines.empty()) {
+        batch.seq = batchCnt;
+        batch.last = true;
+        batch_queues[batchCnt % threadCnt]->push(batch);
+        batchCnt++;
+    }
+    
+    // Wait until decoder threads decode remaining lines
+    for (unsigned worker = 0; worker < threadCnt; worker++) batch_queues[worker]->close();
+    for (thread& decoder_thread : decoder_threads) decoder_thread.join();
+    
+    // Wait until writer threads write remaining content
+    for (thread& writer_thread : writer_threads) writer_thread.join();
+    
+    for (const DecoderStats& workerStats : stats) {
+        total.lines.malformedCnt += workerStats.malformedCnt;
+        total.lines.checksumErrCnt += workerStats.checksumErrCnt;
+        total.lines.incompleteCnt += workerStats.incompleteCnt;
+    }
+    for (const unique_ptr<RecordRing>& ring : write_rings) {
+        total.fullStalls += ring->fullStalls();
+        total.emptyStalls += ring->emptyStalls();
+    }
+    return std::find(writeSuccess.begin(), writeSuccess.end(), 0) == writeSuccess.end();
+    
+}
+
+/**
+ *    \fn           bool processChunked(MappedFileReader& file_reader, const string& outputDirPath, const ProcessingOptions& options, ProcessingStats& total)
+ *    \brief        Processes parts of input file independently by worker threads
+ *    \param[in]    file_reader
+ *                    Reader of the input file
+ *    \param[in]    outputDirPath
+ *                    Path of the output directory
+ *    \param[in]    options
+ *                    Options of processing
+ *    \param[out]    total
+ *                    Statistics of processing
+ *    \return       Boolean value determining if all output files were written successfully
+ *    \note         File is split into parts at line boundaries. Every thread reads and decodes its
+ *                  parts on its own and idle threads steal parts of busy ones. Lines preceding a part
+ *                  restore messages it continues. Outputs of parts are written in the order of the
+ *                  parts, so output files are identical to the ones created by processStreaming().
+ */
+bool processChunked(MappedFileReader& file_reader, const string& outputDirPath, const ProcessingOptions& options, ProcessingStats& total)
+{
+    unsigned threadCnt = options.chunkThreadCnt;
+    VesselFileWriter file_writer(outputDirPath, options.maxOpenFiles, DEFAULT_VESSEL_FLUSH_THRESHOLD,
+                                 static_cast<size_t>(options.writeBufferMB)*1024*1024);
+    
+    // Split file into parts at line boundaries, at least one part per thread
+    size_t fileSize = file_reader.size();
+    size_t chunkCnt = std::max<size_t>((fileSize + PIPELINE_CHUNK_SIZE - 1) / PIPELINE_CHUNK_SIZE, threadCnt);
+    vector<size_t> chunkBegins(chunkCnt + 1);
+    for (size_t chunk = 0; chunk < chunkCnt; chunk++) chunkBegins[chunk] = file_reader.nextLineStart(fileSize / chunkCnt * chunk);
+    chunkBegins[chunkCnt] = fileSize;
+    
+    // Start worker threads
+    WorkStealingPool pool(chunkCnt, threadCnt);
+    OrderedChunkWriter chunk_writer(chunkCnt, static_cast<size_t>(threadCnt)*PIPELINE_WAITING_CHUNKS_PER_THREAD, file_writer);
+    vector<DecoderStats> stats(threadCnt);
+    vector<char> writeSuccess(threadCnt, 1);
+    vector<thread> worker_threads;
+    for (unsigned worker = 0; worker < threadCnt; worker++) {
+        worker_threads.emplace_back([worker, chunkCnt, &options, &file_reader, &chunkBegins, &pool, &chunk_writer, &stats, &writeSuccess]() {
+            ChunkOutput output;
+            DecoderStats workerStats;
+            FragmentReassembler reassembler(options.filter.types());
+            ScratchArena arena;
+            size_t chunk;
+            while (pool.next(worker, chunk)) {
+                chunk_writer.waitForTurn(chunk);
+                processChunk(file_reader, chunkBegins[chunk], chunkBegins[chunk+1], chunk + 1 == chunkCnt, output, workerStats, options, reassembler, arena);
+                if (!chunk_writer.commit(chunk, output)) writeSuccess[worker] = 0;
+                
+                // Inform user about the progress
+                cout << ".";
+            }
+            workerStats.incompleteCnt += static_cast<unsigned>(reassembler.droppedCnt());
+            stats[worker] = workerStats;
+        });
+    }
+    for (thread& worker_thread : worker_threads) worker_thread.join();
+    bool success = file_writer.closeAll() && std::find(writeSuccess.begin(), writeSuccess.end(), 0) == writeSuccess.end();
+    
+    for (const DecoderStats& workerStats : stats) {
+        total.lines.malformedCnt += workerStats.malformedCnt;
+        total.lines.checksumErrCnt += workerStats.checksumErrCnt;
+        total.lines.incompleteCnt += workerStats.incompleteCnt;
+    }
+    total.stolenChunkCnt = pool.stolenCnt();
+    total.maxWaitingChunkCnt = chunk_writer.maxWaitingCnt();
+    return success;
 }
 
 /**
@@ -66,6 +592,20 @@ int main(int argc, const char * argv[])
         cout << "USER GUIDE:" << endl;
         cout << "\t[1st parmeter]: relative input file path" << endl;
         cout << "\t[2nd parameter]: relative output folder file path" << endl;
+        cout << "OPTIONS:" << endl;
+        cout << "\t--max-open-files N: number of output files kept open at once (default " << DEFAULT_MAX_OPEN_FILES << ")" << endl;
+        cout << "\t--write-buffer-mb N: memory for buffered output in MB (default " << DEFAULT_WRITE_BUFFER_BUDGET/(1024*1024) << ")" << endl;
+        cout << "\t--ring-size-kb N: capacity of queues feeding each writer thread in kB (default " << DEFAULT_RING_CAPACITY/1024 << ")," << endl;
+        cout << "\t                  shared by decoder threads, each share must hold " << ringRecordSize(OUTPUT_RECORD_MAX_SIZE) << " bytes" << endl;
+        cout << "\t--threads N: number of decoder threads (default 1)" << endl;
+        cout << "\t--writer-threads N: number of writer threads (default one per 4 decoder threads)" << endl;
+        cout << "\t--chunk-threads N: split input file into parts processed independently by N threads" << endl;
+        cout << "\t--types T1,T2,...: message types to be written, out of 1, 2 and 3 (default 1,3)" << endl;
+        cout << "\t--mmsi-list M1,M2,... or @FILE: senders to be written, listed directly or in a file" << endl;
+        cout << "\t--bbox LON1,LAT1,LON2,LAT2: area in degrees containing positions to be written" << endl;
+        cout << "\t                           (LON1 greater than LON2 selects area crossing the antimeridian)" << endl;
+        cout << "\t--fields F1,F2,...: written fields, out of time, type, count, mmsi, status, rot, sog," << endl;
+        cout << "\t                    accuracy, lon, lat, cog, hdg, timestamp and maneuver (default all)" << endl;
         cout << "EXAMPLE:" << endl;
         cout << "\t'./SSD_Task1 ./AIS_messages.txt ./'" << endl;
         cout << "----------------------------------------------------------" << endl;
@@ -74,61 +614,67 @@ int main(int argc, const char * argv[])
     }
     
     // Detect wrong number of arguments
-    if (argc != 3) {
+    if (argc < 3 || (argc - 3) % 2 != 0) {
         cout << "(ERROR) Wrong number of arguments" << endl;
         cin.get();
         return -1;
     }
     
+    // Parse options following the paths
+    ProcessingOptions options;
+    for (int i = 3; i < argc; i += 2) {
+        parameter.assign(argv[i]);
+        bool valid = false;
+        if (parameter == "--max-open-files") valid = parseUnsignedOption(argv[i+1], options.maxOpenFiles) && options.maxOpenFiles > 0;
+        else if (parameter == "--write-buffer-mb") valid = parseUnsignedOption(argv[i+1], options.writeBufferMB);
+        else if (parameter == "--ring-size-kb") valid = parseUnsignedOption(argv[i+1], options.ringSizeKB) && options.ringSizeKB > 0;
+        else if (parameter == "--threads") valid = parseUnsignedOption(argv[i+1], options.threadCnt) && options.threadCnt > 0;
+        else if (parameter == "--writer-threads") valid = parseUnsignedOption(argv[i+1], options.writerCnt) && options.writerCnt > 0;
+        else if (parameter == "--chunk-threads") valid = parseUnsignedOption(argv[i+1], options.chunkThreadCnt) && options.chunkThreadCnt > 0;
+        else if (parameter == "--types") valid = options.filter.setTypes(argv[i+1]);
+        else if (parameter == "--mmsi-list") valid = options.filter.setMMSIList(argv[i+1]);
+        else if (parameter == "--bbox") valid = options.filter.setBoundingBox(argv[i+1]);
+        else if (parameter == "--fields") valid = parseReportFields(argv[i+1], options.fields);
+        if (!valid) {
+            cout << "(ERROR) Wrong option: " << parameter << " " << argv[i+1] << endl;
+            cin.get();
+            return -1;
+        }
+    }
+    
+    // Every queue feeding a writer thread must hold the longest output record
+    if (options.chunkThreadCnt == 0 &&
+        static_cast<size_t>(options.ringSizeKB)*1024/options.threadCnt < ringRecordSize(OUTPUT_RECORD_MAX_SIZE)) {
+        cout << "(ERROR) Writer queues of " << options.ringSizeKB << " kB cannot hold output records of "
+             << options.threadCnt << " decoder threads" << endl;
+        cin.get();
+        return -1;
+    }
+    
     // Prepare file reader and writer
     string readFilePath(argv[1]);
-    ifstream file_reader(readFilePath);
-    if ( !file_reader.is_open() ) {
+    MappedFileReader file_reader;
+    if ( !file_reader.open(readFilePath) ) {
         cout << "(ERROR) Could not open input file: " << readFilePath << endl;
         cin.get();
         return -1;
     }
     string outputDirPath(argv[2]);
-    ofstream file_writer;
-    
-    // Initialize STL maps
-    initASCIIToBytesMap();
-    initMessageTypesMap();
-    initNavigationStatusMap();
     
-    // Read input file line by line
+    // Process whole file
     cout << "Processing data" << endl;
-    lineContent line;
-    unsigned lineCnt = 0;
-    while (readLineFromFile(line,file_reader)) {
-        
-        // Convert message to binary format
-        byte* msgBin = new byte[line.AISMsg.payload.length()];
-        convertAISMsgStringToBinaryFormat(line.AISMsg.payload,msgBin);
-        
-        // Extract  messages of type 1 and 3
-        if (extractMessageType(msgBin) == 1 || extractMessageType(msgBin) == 3) {
-            
-            // Define output content
-            string content = line.date + " " + line.time + "\n" + decodeAISMsg(msgBin) + "\n";
-            string MMSI = getMMSI(extractMMSI(msgBin));
-            
-            // Put message info in proper file
-            putMessageInFile(MMSI, content, file_writer, outputDirPath);
-            
-            // Print out content of each write
-            //cout << content;
-        }
-        
-        // Free the dynamically allocated memory
-        delete[] msgBin;
-        
-        // Inform user about the progress
-        if(lineCnt%1000 == 0) cout << ".";
-        lineCnt++;
-    }
+    ProcessingStats stats;
+    bool writeSuccess = (options.chunkThreadCnt > 0) ? processChunked(file_reader, outputDirPath, options, stats)
+                                             : processStreaming(file_reader, outputDirPath, options, stats);
+    if (!writeSuccess) cout << endl << "(WARNING) Some output files could not be written";
     
-    cout << endl << "Processing finished successfully" << endl;
+    cout << endl;
+    if (stats.lines.checksumErrCnt > 0) cout << "(WARNING) Skipped lines with invalid checksum: " << stats.lines.checksumErrCnt << endl;
+    if (stats.lines.malformedCnt > 0) cout << "(WARNING) Skipped malformed lines: " << stats.lines.malformedCnt << endl;
+    if (stats.lines.incompleteCnt > 0) cout << "(WARNING) Skipped incomplete multi-sentence messages: " << stats.lines.incompleteCnt << endl;
+    if (options.chunkThreadCnt > 0) cout << "Chunks stolen by idle threads: " << stats.stolenChunkCnt << ", waiting for commit at most: " << stats.maxWaitingChunkCnt << endl;
+    else cout << "Writer queue stalls: " << stats.fullStalls << " full, " << stats.emptyStalls << " empty" << endl;
+    cout << "Processing finished successfully" << endl;
     cin.get();
 
     return 0;
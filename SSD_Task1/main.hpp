@@ -12,8 +12,6 @@
 #ifndef main_hpp
 #define main_hpp
 
-using namespace std;
-
 //! Definition of byte variable type
 typedef unsigned char byte;
 
@@ -0,0 +1,129 @@
+/**
+ * \file pipeline.cpp
+ *
+ * \brief Distribution of input lines among threads.
+ *
+ * \details This file includes definitions of functions of queue passing batches of input lines from the reading thread to decoding threads.
+ *
+ * \date    16/10/2026
+ */
+
+#include <utility>
+#include "pipeline.hpp"
+
+using std::unique_lock;
+using std::lock_guard;
+
+BatchQueue::BatchQueue(size_t depth)
+: m_depth(depth > 0 ? depth : 1), m_closed(false)
+{
+}
+
+/**
+ *    \fn           void BatchQueue::push(LineBatch& batch)
+ *    \brief        Moves batch into the queue, waiting for free space if needed
+ *    \param[in,out] batch
+ *                    Batch to be queued (left empty)
+ */
+void BatchQueue::push(LineBatch& batch)
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_notFull.wait(lock, [this]() { return m_batches.size() < m_depth; });
+    m_batches.push_back(std::move(batch));
+    batch = LineBatch();
+    lock.unlock();
+    m_notEmpty.notify_one();
+}
+
+/**
+ *    \fn           bool BatchQueue::pop(LineBatch& batch)
+ *    \brief        Takes the oldest batch, waiting for it if the queue is empty
+ *    \param[out]    batch
+ *                    Taken batch
+ *    \return       Boolean value determining if batch was taken (false if queue is empty and closed)
+ */
+bool BatchQueue::pop(LineBatch& batch)
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_notEmpty.wait(lock, [this]() { return !m_batches.empty() || m_closed; });
+    if (m_batches.empty()) return false;
+    batch = std::move(m_batches.front());
+    m_batches.pop_front();
+    lock.unlock();
+    m_notFull.notify_one();
+    return true;
+}
+
+/**
+ *    \fn           void BatchQueue::close()
+ *    \brief        Marks that no more batches will be pushed
+ */
+void BatchQueue::close()
+{
+    {
+        unique_lock<mutex> lock(m_mutex);
+        m_closed = true;
+    }
+    m_notEmpty.notify_all();
+}
+
+WorkStealingPool::WorkStealingPool(size_t taskCnt, unsigned threadCnt)
+: m_threadCnt(threadCnt > 0 ? threadCnt : 1), m_queues(new TaskQueue[threadCnt > 0 ? threadCnt : 1])
+{
+    for (size_t task = 0; task < taskCnt; task++) m_queues[task % m_threadCnt].tasks.push_back(task);
+}
+
+/**
+ *    \fn           bool WorkStealingPool::next(unsigned thread, size_t& task)
+ *    \brief        Takes next task of the thread or steals one from another thread
+ *    \param[in]    thread
+ *                    Index of the calling thread
+ *    \param[out]    task
+ *                    Number of the taken task
+ *    \return       Boolean value determining if task was taken (false if all tasks were taken)
+ */
+bool WorkStealingPool::next(unsigned thread, size_t& task)
+{
+    {
+        lock_guard<mutex> lock(m_queues[thread].lock);
+        if (!m_queues[thread].tasks.empty()) {
+            task = m_queues[thread].tasks.front();
+            m_queues[thread].tasks.pop_front();
+            return true;
+        }
+    }
+    
+    // Steal from the thread having the most work left, retry if someone was faster
+    while (true) {
+        unsigned victim = m_threadCnt;
+        size_t longest = 0;
+        for (unsigned other = 0; other < m_threadCnt; other++) {
+            if (other == thread) continue;
+            lock_guard<mutex> lock(m_queues[other].lock);
+            if (m_queues[other].tasks.size() > longest) {
+                longest = m_queues[other].tasks.size();
+                victim = other;
+            }
+        }
+        if (victim == m_threadCnt) return false;
+        
+        lock_guard<mutex> lock(m_queues[victim].lock);
+        if (m_queues[victim].tasks.empty()) continue;
+        task = m_queues[victim].tasks.back();
+        m_queues[victim].tasks.pop_back();
+        m_queues[thread].stolen++;
+        return true;
+    }
+}
+
+/**
+ *    \fn           size_t WorkStealingPool::stolenCnt() const
+ *    \brief        Returns number of tasks taken from queues of other threads
+ *    \warning      Result is exact only after all threads have finished
+ */
+size_t WorkStealingPool::stolenCnt() const
+{
+    size_t stolen = 0;
+    for (unsigned thread = 0; thread < m_threadCnt; thread++) stolen += m_queues[thread].stolen;
+    return stolen;
+}
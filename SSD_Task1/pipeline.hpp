@@ -0,0 +1,173 @@
+/**
+ * \file pipeline.hpp
+ *
+ * \brief Header file of 'pipeline.cpp'.
+ *
+ * \details This file includes declarations of structures used for distributing batches of input lines among decoding threads.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef pipeline_hpp
+#define pipeline_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include "read.hpp"
+
+using std::vector;
+using std::deque;
+using std::unique_ptr;
+using std::mutex;
+using std::condition_variable;
+
+//! Number of lines passed to a decoding thread at once
+#define PIPELINE_BATCH_LINES 1024
+//! Number of batches waiting for a single decoding thread
+#define PIPELINE_QUEUE_DEPTH 4
+//! Approximate size of a part of the input file processed independently in bytes
+#define PIPELINE_CHUNK_SIZE (16 * 1024 * 1024)
+//! Number of processed parts of the input file per thread which may wait for being written
+#define PIPELINE_WAITING_CHUNKS_PER_THREAD 2
+
+/**
+ *    \struct       NumberedLine
+ *    \brief        Structure for storing line of the input file together with its number
+ */
+struct NumberedLine {
+    size_t num;                 /*!< Number of the line in the input file */
+    lineView line;              /*!< Views of line components */
+};
+
+/**
+ *    \struct       LineBatch
+ *    \brief        Structure for storing consecutive lines of the input file
+ */
+struct LineBatch {
+    size_t seq = 0;                 /*!< Sequence number of the batch in the input file */
+    size_t firstLine = 0;           /*!< Number of the first line of the batch in the input file */
+    bool last = false;              /*!< Determines if batch ends the input file */
+    vector<lineView> lines;         /*!< Views of lines of the batch */
+    vector<NumberedLine> context;   /*!< Multi-sentence lines among REASSEMBLY_WINDOW_LINES lines preceding the batch */
+};
+
+/**
+ *    \class        BatchQueue
+ *    \brief        Bounded blocking queue passing batches from the reading thread to a decoding thread
+ */
+class BatchQueue {
+public:
+    /**
+     *    \fn           BatchQueue(size_t depth)
+     *    \brief        Creates empty queue
+     *    \param[in]    depth
+     *                    Maximal number of waiting batches
+     */
+    explicit BatchQueue(size_t depth = PIPELINE_QUEUE_DEPTH);
+    BatchQueue(const BatchQueue&) = delete;
+    BatchQueue& operator=(const BatchQueue&) = delete;
+
+    /**
+     *    \fn           void push(LineBatch& batch)
+     *    \brief        Moves batch into the queue, waiting for free space if needed
+     *    \param[in,out] batch
+     *                    Batch to be queued (left empty)
+     */
+    void push(LineBatch& batch);
+    /**
+     *    \fn           bool pop(LineBatch& batch)
+     *    \brief        Takes the oldest batch, waiting for it if the queue is empty
+     *    \param[out]    batch
+     *                    Taken batch
+     *    \return       Boolean value determining if batch was taken (false if queue is empty and closed)
+     */
+    bool pop(LineBatch& batch);
+    /**
+     *    \fn           void close()
+     *    \brief        Marks that no more batches will be pushed
+     */
+    void close();
+
+private:
+    size_t m_depth;                     /*!< Maximal number of waiting batches */
+    bool m_closed;                      /*!< Determines if producer has finished */
+    deque<LineBatch> m_batches;         /*!< Waiting batches */
+    mutex m_mutex;                      /*!< Protects all members */
+    condition_variable m_notEmpty;      /*!< Signalled when batch is pushed or queue is closed */
+    condition_variable m_notFull;       /*!< Signalled when batch is popped */
+};
+
+/**
+ *    \class        WorkStealingPool
+ *    \brief        Set of task numbers shared by threads which take tasks from each other when idle
+ *    \details      Every thread has its own queue of tasks. Tasks are dealt in turns, so that threads
+ *                  work on neighbouring tasks. Thread takes tasks from the front of its own queue and,
+ *                  when it is empty, steals from the back of the longest queue of other threads.
+ */
+class WorkStealingPool {
+public:
+    /**
+     *    \fn           WorkStealingPool(size_t taskCnt, unsigned threadCnt)
+     *    \brief        Deals tasks among threads
+     *    \param[in]    taskCnt
+     *                    Number of tasks (tasks are numbered from 0)
+     *    \param[in]    threadCnt
+     *                    Number of threads
+     */
+    WorkStealingPool(size_t taskCnt, unsigned threadCnt);
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    /**
+     *    \fn           bool next(unsigned thread, size_t& task)
+     *    \brief        Takes next task of the thread or steals one from another thread
+     *    \param[in]    thread
+     *                    Index of the calling thread
+     *    \param[out]    task
+     *                    Number of the taken task
+     *    \return       Boolean value determining if task was taken (false if all tasks were taken)
+     */
+    bool next(unsigned thread, size_t& task);
+    /**
+     *    \fn           size_t stolenCnt() const
+     *    \brief        Returns number of tasks taken from queues of other threads
+     */
+    size_t stolenCnt() const;
+
+private:
+    /**
+     *    \struct       TaskQueue
+     *    \brief        Queue of tasks of a single thread
+     */
+    struct alignas(64) TaskQueue {
+        mutex lock;             /*!< Protects the tasks */
+        deque<size_t> tasks;    /*!< Numbers of tasks not taken yet */
+        size_t stolen = 0;      /*!< Number of tasks stolen by this thread */
+    };
+
+    unsigned m_threadCnt;               /*!< Number of threads */
+    unique_ptr<TaskQueue[]> m_queues;   /*!< Queues of all threads */
+};
+
+/**
+ *    \fn           unsigned shardOfMMSI(unsigned MMSI, unsigned shardCnt)
+ *    \brief        Assigns vessel to one of the writing threads
+ *    \param[in]    MMSI
+ *                    MMSI number of the vessel
+ *    \param[in]    shardCnt
+ *                    Number of writing threads
+ *    \return       Index of the writing thread
+ */
+inline unsigned shardOfMMSI(unsigned MMSI, unsigned shardCnt)
+{
+    // MMSI numbers of one country share leading digits, mix all bits of the key
+    uint64_t h = static_cast<uint64_t>(MMSI) * 0x9E3779B97F4A7C15ull;
+    return static_cast<unsigned>((h >> 32) % shardCnt);
+}
+
+#endif /* pipeline_hpp */
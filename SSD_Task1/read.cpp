@@ -13,8 +13,23 @@
 #include <fstream>
 #include <vector>
 #include <sstream>
+#include <cstring>
+#include <algorithm>
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 #include "read.hpp"
 
+using std::stringstream;
+using std::vector;
+
 /**
  *    \fn           void splitElementsOfAISMessage(string& AISString, AISMessage& AISMsg)
  *    \brief        Splits comma separated elements of AIS message
@@ -41,6 +56,58 @@ void splitElementsOfAISMessage(string& AISString, AISMessage& AISMsg)
     AISMsg.size = AISMsgElements.at(6);
 }
 
+/**
+ *    \fn           AISParseStatus assignElementsOfAISMessage(const string_view* AISMsgElements, AISMessageView& AISMsg)
+ *    \brief        Assigns split elements to the components of AIS message
+ *    \param[in]    AISMsgElements
+ *                    Array of AIS_MSG_ELEMENTS_NUM views of message elements
+ *    \param[out]    AISMsg
+ *                    Structure for storing views of message elements
+ *    \return       Status of the operation
+ */
+static AISParseStatus assignElementsOfAISMessage(const string_view* AISMsgElements, AISMessageView& AISMsg)
+{
+    AISMsg.format = AISMsgElements[0];
+    AISMsg.msgCnt = AISMsgElements[1];
+    AISMsg.msgNum = AISMsgElements[2];
+    AISMsg.seqID = AISMsgElements[3];
+    AISMsg.channel = AISMsgElements[4];
+    AISMsg.payload = AISMsgElements[5];
+    AISMsg.size = AISMsgElements[6];
+    
+    if (AISMsg.payload.empty()) return AIS_PARSE_EMPTY_PAYLOAD;
+    return AIS_PARSE_OK;
+}
+
+/**
+ *    \fn           AISParseStatus splitElementsOfAISMessage(string_view AISString, AISMessageView& AISMsg)
+ *    \brief        Splits comma separated elements of AIS message without copying them
+ *    \param[in]    AISString
+ *                    AIS message string
+ *    \param[out]    AISMsg
+ *                    Structure for storing views of extracted substrings
+ *    \return       Status of the operation
+ *    \note         Separators are located in a single pass over the message and no memory is allocated
+ */
+AISParseStatus splitElementsOfAISMessage(string_view AISString, AISMessageView& AISMsg)
+{
+    // Find comma separated elements of AIS message
+    string_view AISMsgElements[AIS_MSG_ELEMENTS_NUM];
+    const char* pos = AISString.data();
+    const char* end = pos + AISString.size();
+    int k = 0;
+    while (k < AIS_MSG_ELEMENTS_NUM) {
+        const char* begin = pos;
+        while (pos < end && *pos != ',') pos++;
+        AISMsgElements[k++] = string_view(begin, pos - begin);
+        if (pos == end) break;
+        pos++; // skip the comma
+    }
+    if (k < AIS_MSG_ELEMENTS_NUM) return AIS_PARSE_TOO_FEW_ELEMENTS;
+    
+    return assignElementsOfAISMessage(AISMsgElements, AISMsg);
+}
+
 /**
  *    \fn           bool readLineFromFile(lineContent& line, ifstream& file_reader)
  *    \brief        Main program performing AIS messages processing
@@ -65,3 +132,346 @@ bool readLineFromFile(lineContent& line, ifstream& file_reader)
     
     return true;
 }
+
+/**
+ *    \fn           bool isLineWhitespace(char c)
+ *    \brief        Checks if character separates components of the line
+ *    \param[in]    c
+ *                    Checked character
+ *    \return       Boolean value determining if character is a separator
+ */
+static inline bool isLineWhitespace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ *    \fn           string_view nextToken(const char*& pos, const char* end)
+ *    \brief        Returns next whitespace separated token of the line
+ *    \param[in,out] pos
+ *                    Current position inside the line, moved past returned token
+ *    \param[in]    end
+ *                    End of the line
+ *    \return       View of the token (empty if line has ended)
+ */
+static inline string_view nextToken(const char*& pos, const char* end)
+{
+    while (pos < end && isLineWhitespace(*pos)) pos++;
+    const char* begin = pos;
+    while (pos < end && !isLineWhitespace(*pos)) pos++;
+    return string_view(begin, pos - begin);
+}
+
+/**
+ *    \fn           string_view trimWhitespace(const char* begin, const char* end)
+ *    \brief        Returns view of the character range without leading and trailing whitespace
+ *    \param[in]    begin
+ *                    Beginning of the range
+ *    \param[in]    end
+ *                    End of the range
+ *    \return       View of the trimmed range
+ */
+static inline string_view trimWhitespace(const char* begin, const char* end)
+{
+    while (begin < end && isLineWhitespace(*begin)) begin++;
+    while (end > begin && isLineWhitespace(*(end-1))) end--;
+    return string_view(begin, end - begin);
+}
+
+MappedFileReader::MappedFileReader()
+: m_data(nullptr), m_size(0), m_position(0), m_isOpen(false), m_ownsMapping(false), m_indexBase(0), m_indexEnd(0), m_indexPos(0)
+#ifdef _WIN32
+, m_fileHandle(INVALID_HANDLE_VALUE), m_mappingHandle(nullptr)
+#else
+, m_fileDescriptor(-1)
+#endif
+{
+}
+
+MappedFileReader::~MappedFileReader()
+{
+    close();
+}
+
+/**
+ *    \fn           bool MappedFileReader::open(const string& filePath)
+ *    \brief        Maps file into memory
+ *    \param[in]    filePath
+ *                    Path of the input file
+ *    \return       Boolean value determining if mapping was successful
+ *    \note         Empty file is reported as successfully opened file without any lines
+ */
+bool MappedFileReader::open(const string& filePath)
+{
+    close();
+    
+#ifdef _WIN32
+    m_fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                               OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (m_fileHandle == INVALID_HANDLE_VALUE) return false;
+    
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(m_fileHandle, &fileSize)) {
+        close();
+        return false;
+    }
+    m_size = static_cast<size_t>(fileSize.QuadPart);
+    
+    if (m_size > 0) {
+        m_mappingHandle = CreateFileMappingA(m_fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (m_mappingHandle == nullptr) {
+            close();
+            return false;
+        }
+        m_data = static_cast<const char*>(MapViewOfFile(m_mappingHandle, FILE_MAP_READ, 0, 0, 0));
+        if (m_data == nullptr) {
+            close();
+            return false;
+        }
+    }
+#else
+    m_fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+    if (m_fileDescriptor < 0) return false;
+    
+    struct stat fileStat;
+    if (fstat(m_fileDescriptor, &fileStat) != 0) {
+        close();
+        return false;
+    }
+    m_size = static_cast<size_t>(fileStat.st_size);
+    
+    if (m_size > 0) {
+        void* mapping = mmap(nullptr, m_size, PROT_READ, MAP_PRIVATE, m_fileDescriptor, 0);
+        if (mapping == MAP_FAILED) {
+            close();
+            return false;
+        }
+        // File is read once from the beginning to the end
+        madvise(mapping, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(mapping);
+    }
+#endif
+    
+    m_position = 0;
+    m_indexBase = m_indexEnd = 0;
+    m_indexPos = m_index.count = 0;
+    m_isOpen = true;
+    m_ownsMapping = true;
+    return true;
+}
+
+/**
+ *    \fn           bool MappedFileReader::openRange(const MappedFileReader& file_reader, size_t begin, size_t end)
+ *    \brief        Reads lines from a part of file mapped by another reader
+ *    \param[in]    file_reader
+ *                    Reader owning the mapping
+ *    \param[in]    begin
+ *                    Offset of the first line of the part
+ *    \param[in]    end
+ *                    Offset following the last line of the part
+ *    \return       Boolean value determining if the part lies within the mapping
+ *    \note         Offsets should be obtained with nextLineStart(), so that lines are not cut
+ *    \warning      Mapping must stay open as long as this reader is used
+ */
+bool MappedFileReader::openRange(const MappedFileReader& file_reader, size_t begin, size_t end)
+{
+    close();
+    if (!file_reader.is_open() || begin > end || end > file_reader.size()) return false;
+    
+    // Reading stops at the end of the part as if it was the end of the file
+    m_data = file_reader.data();
+    m_size = end;
+    m_position = begin;
+    m_isOpen = true;
+    m_ownsMapping = false;
+    return true;
+}
+
+/**
+ *    \fn           size_t MappedFileReader::nextLineStart(size_t offset) const
+ *    \brief        Finds beginning of the first line starting at or after given offset
+ *    \param[in]    offset
+ *                    Offset in the mapping
+ *    \return       Offset of the line or size of the mapping if there is no such line
+ */
+size_t MappedFileReader::nextLineStart(size_t offset) const
+{
+    if (offset == 0 || offset >= m_size) return std::min(offset, m_size);
+    const char* newline = static_cast<const char*>(memchr(m_data + offset - 1, '\n', m_size - offset + 1));
+    return (newline != nullptr) ? static_cast<size_t>(newline - m_data) + 1 : m_size;
+}
+
+/**
+ *    \fn           size_t MappedFileReader::lineStartBefore(size_t offset, size_t lineCnt) const
+ *    \brief        Finds beginning of the line given number of lines before the line at given offset
+ *    \param[in]    offset
+ *                    Offset of the beginning of a line in the mapping
+ *    \param[in]    lineCnt
+ *                    Number of lines to go back, empty lines included
+ *    \return       Offset of the found line or 0 if there are fewer lines before the offset
+ */
+size_t MappedFileReader::lineStartBefore(size_t offset, size_t lineCnt) const
+{
+    // Character before the line ends the previous one, its beginning follows the newline before it
+    size_t position = std::min(offset, m_size);
+    for (; position > 0 && lineCnt > 0; lineCnt--) {
+        position--;
+        while (position > 0 && m_data[position - 1] != '\n') position--;
+    }
+    return position;
+}
+
+/**
+ *    \fn           void MappedFileReader::close()
+ *    \brief        Unmaps file and releases its handles
+ */
+void MappedFileReader::close()
+{
+#ifdef _WIN32
+    if (m_data && m_ownsMapping) UnmapViewOfFile(m_data);
+    if (m_mappingHandle) CloseHandle(m_mappingHandle);
+    if (m_fileHandle != INVALID_HANDLE_VALUE) CloseHandle(m_fileHandle);
+    m_mappingHandle = nullptr;
+    m_fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if (m_data && m_ownsMapping) munmap(const_cast<char*>(m_data), m_size);
+    if (m_fileDescriptor >= 0) ::close(m_fileDescriptor);
+    m_fileDescriptor = -1;
+#endif
+    m_data = nullptr;
+    m_size = 0;
+    m_position = 0;
+    m_indexBase = m_indexEnd = 0;
+    m_indexPos = m_index.count = 0;
+    m_isOpen = false;
+    m_ownsMapping = false;
+}
+
+/**
+ *    \fn           bool MappedFileReader::indexNextBlock()
+ *    \brief        Builds structural index of the block starting at the next line
+ *    \return       Boolean value determining if the block contains at least one complete line
+ *    \note         Index is truncated after the last newline of the block, so that lines crossing
+ *                  the block boundary are indexed again as a part of the next block
+ */
+bool MappedFileReader::indexNextBlock()
+{
+    m_indexBase = m_position;
+    m_indexEnd = m_indexBase + std::min<size_t>(STRUCTURAL_BLOCK_SIZE, m_size - m_indexBase);
+    m_indexPos = 0;
+    buildStructuralIndex(m_data + m_indexBase, m_indexEnd - m_indexBase, m_index);
+    
+    // Last line of the file does not need to be terminated
+    if (m_indexEnd == m_size) return true;
+    
+    // Drop positions following the last newline of the block
+    while (m_index.count > 0 && m_data[m_indexBase + m_index.positions[m_index.count-1]] != '\n') {
+        m_index.count--;
+    }
+    m_indexEnd = (m_index.count > 0) ? m_indexBase + m_index.positions[m_index.count-1] + 1 : m_indexBase;
+    return m_index.count > 0;
+}
+
+/**
+ *    \fn           bool MappedFileReader::readLine(lineView& line)
+ *    \brief        Returns next non-empty line of the mapped file
+ *    \param[out]   line
+ *                    Structure for storing views of line components
+ *    \return       Boolean value determining if reading was successful
+ *    \note         Return value can be used to detect EOF
+ */
+bool MappedFileReader::readLine(lineView& line)
+{
+    while (m_position < m_size) {
+        
+        const char* begin = m_data + m_position;
+        const char* end = nullptr;
+        const char* tabs[2];
+        const char* commas[AIS_MSG_ELEMENTS_NUM];
+        int tabCnt = 0;
+        int commaCnt = 0;
+        
+        if (m_position >= m_indexEnd && !indexNextBlock()) {
+            
+            // Line does not fit into a single block, find its end character by character
+            end = static_cast<const char*>(memchr(begin, '\n', m_size - m_position));
+            if (end == nullptr) end = m_data + m_size;
+        }
+        else {
+            
+            // Collect structural characters of the current line from the index
+            const uint32_t* positions = m_index.positions.data();
+            while (m_indexPos < m_index.count) {
+                const char* pos = m_data + m_indexBase + positions[m_indexPos++];
+                if (*pos == '\n') {
+                    end = pos;
+                    break;
+                }
+                else if (*pos == '\t') {
+                    if (tabCnt < 2) tabs[tabCnt] = pos;
+                    tabCnt++;
+                }
+                else if (*pos == ',' && tabCnt == 2 && commaCnt < AIS_MSG_ELEMENTS_NUM) {
+                    commas[commaCnt++] = pos;
+                }
+            }
+            if (end == nullptr) end = m_data + m_indexEnd; // unterminated last line
+        }
+        m_position = (end - m_data) + 1;
+        
+        if (tabCnt == 2) {
+            
+            // Split tab separated line using indexed positions
+            line.date = trimWhitespace(begin, tabs[0]);
+            line.time = trimWhitespace(tabs[0] + 1, tabs[1]);
+            line.sentence = trimWhitespace(tabs[1] + 1, end);
+            if (line.sentence.empty()) continue;
+            
+            const char* sentenceEnd = line.sentence.data() + line.sentence.size();
+            if (commaCnt < AIS_MSG_ELEMENTS_NUM - 1) {
+                line.AISMsgStatus = AIS_PARSE_TOO_FEW_ELEMENTS;
+            }
+            else {
+                string_view AISMsgElements[AIS_MSG_ELEMENTS_NUM];
+                const char* elementBegin = line.sentence.data();
+                for (int k = 0; k < AIS_MSG_ELEMENTS_NUM; k++) {
+                    const char* elementEnd = (k < commaCnt) ? commas[k] : sentenceEnd;
+                    AISMsgElements[k] = string_view(elementBegin, elementEnd - elementBegin);
+                    elementBegin = elementEnd + 1;
+                }
+                line.AISMsgStatus = assignElementsOfAISMessage(AISMsgElements, line.AISMsg);
+            }
+        }
+        else {
+            
+            // Split line into whitespace separated components
+            const char* pos = begin;
+            line.date = nextToken(pos, end);
+            line.time = nextToken(pos, end);
+            line.sentence = nextToken(pos, end);
+            if (line.sentence.empty()) continue;
+            
+            line.AISMsgStatus = splitElementsOfAISMessage(line.sentence, line.AISMsg);
+        }
+        
+        return true;
+    }
+    
+    return false; // on file end
+}
+
+/**
+ *    \fn           bool readLineFromFile(lineView& line, MappedFileReader& file_reader)
+ *    \brief        Reads next line of memory mapped file without copying its content
+ *    \param[out]    line
+ *                    Structure for storing views of line components
+ *    \param[in]    file_reader
+ *                    Reader used for file reading
+ *    \return       Boolean value determining if reading was successful
+ *    \note         Return value can be used to detect EOF
+ *    \warning      Reader must be opened before being passed to the function
+ */
+bool readLineFromFile(lineView& line, MappedFileReader& file_reader)
+{
+    return file_reader.readLine(line);
+}
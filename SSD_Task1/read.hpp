@@ -13,9 +13,14 @@
 #define read_hpp
 
 #include <string>
+#include <string_view>
 #include <fstream>
+#include <cstddef>
+#include "scan.hpp"
 
-using namespace std;
+using std::string;
+using std::string_view;
+using std::ifstream;
 
 //! Number of elements in AISMessage structure
 #define AIS_MSG_ELEMENTS_NUM 7
@@ -34,6 +39,31 @@ struct AISMessage {
     string size;    /*!< Contains size information */
 };
 
+/**
+ *    \struct       AISMessageView
+ *    \brief        Structure for storing views of AIS message components
+ *    \note         Members point into the parsed sentence and are valid as long as the sentence is
+ */
+struct AISMessageView {
+    string_view format;     /*!< Contains format information */
+    string_view msgCnt;     /*!< Contains message counter */
+    string_view msgNum;     /*!< Contains message number */
+    string_view seqID;      /*!< Contains sequence ID */
+    string_view channel;    /*!< Contains channel number */
+    string_view payload;    /*!< Contains message payload */
+    string_view size;       /*!< Contains size information */
+};
+
+/**
+ *    \enum         AISParseStatus
+ *    \brief        Result of splitting AIS message into its components
+ */
+enum AISParseStatus {
+    AIS_PARSE_OK = 0,           /*!< Message was split successfully */
+    AIS_PARSE_TOO_FEW_ELEMENTS, /*!< Message contains less than AIS_MSG_ELEMENTS_NUM elements */
+    AIS_PARSE_EMPTY_PAYLOAD     /*!< Message does not contain any payload */
+};
+
 /**
  *    \struct       lineContent
  *    \brief        Structure for storing components of text line read from file
@@ -44,6 +74,123 @@ struct lineContent {
     AISMessage AISMsg;  /*!< Contains AIS message structure */
 };
 
+/**
+ *    \struct       lineView
+ *    \brief        Structure for storing components of text line read from memory mapped file
+ *    \note         Members point directly into the mapping and are valid as long as the mapping is open
+ */
+struct lineView {
+    string_view date;       /*!< Contains date information */
+    string_view time;       /*!< Contains time information */
+    string_view sentence;   /*!< Contains raw AIS sentence */
+    AISMessageView AISMsg;  /*!< Contains views of AIS message components */
+    AISParseStatus AISMsgStatus; /*!< Contains status of splitting AIS message into components */
+};
+
+/**
+ *    \class        MappedFileReader
+ *    \brief        Reader exposing read-only memory mapping of the input file
+ *    \details      Whole file is mapped into the address space once, subsequent lines are
+ *                  returned as views into the mapping without copying them to the heap.
+ *                  Line components and AIS message elements are located using structural
+ *                  index built for large blocks of the mapping.
+ */
+class MappedFileReader {
+public:
+    MappedFileReader();
+    ~MappedFileReader();
+    MappedFileReader(const MappedFileReader&) = delete;
+    MappedFileReader& operator=(const MappedFileReader&) = delete;
+
+    /**
+     *    \fn           bool open(const string& filePath)
+     *    \brief        Maps file into memory
+     *    \param[in]    filePath
+     *                    Path of the input file
+     *    \return       Boolean value determining if mapping was successful
+     */
+    bool open(const string& filePath);
+    /**
+     *    \fn           bool openRange(const MappedFileReader& file_reader, size_t begin, size_t end)
+     *    \brief        Reads lines from a part of file mapped by another reader
+     *    \param[in]    file_reader
+     *                    Reader owning the mapping
+     *    \param[in]    begin
+     *                    Offset of the first line of the part
+     *    \param[in]    end
+     *                    Offset following the last line of the part
+     *    \return       Boolean value determining if the part lies within the mapping
+     *    \warning      Mapping must stay open as long as this reader is used
+     */
+    bool openRange(const MappedFileReader& file_reader, size_t begin, size_t end);
+    /**
+     *    \fn           void close()
+     *    \brief        Unmaps file and releases its handles
+     */
+    void close();
+    /**
+     *    \fn           bool is_open() const
+     *    \brief        Checks if file is mapped
+     *    \return       Boolean value determining if file is mapped
+     */
+    bool is_open() const { return m_isOpen; }
+    /**
+     *    \fn           bool readLine(lineView& line)
+     *    \brief        Returns next non-empty line of the mapped file
+     *    \param[out]   line
+     *                    Structure for storing views of line components
+     *    \return       Boolean value determining if reading was successful
+     *    \note         Return value can be used to detect EOF
+     */
+    bool readLine(lineView& line);
+
+    /**
+     *    \fn           size_t nextLineStart(size_t offset) const
+     *    \brief        Finds beginning of the first line starting at or after given offset
+     *    \param[in]    offset
+     *                    Offset in the mapping
+     *    \return       Offset of the line or size of the mapping if there is no such line
+     */
+    size_t nextLineStart(size_t offset) const;
+    /**
+     *    \fn           size_t lineStartBefore(size_t offset, size_t lineCnt) const
+     *    \brief        Finds beginning of the line given number of lines before the line at given offset
+     *    \param[in]    offset
+     *                    Offset of the beginning of a line in the mapping
+     *    \param[in]    lineCnt
+     *                    Number of lines to go back, empty lines included
+     *    \return       Offset of the found line or 0 if there are fewer lines before the offset
+     */
+    size_t lineStartBefore(size_t offset, size_t lineCnt) const;
+
+    const char* data() const { return m_data; }     /*!< Returns beginning of the mapping */
+    size_t size() const { return m_size; }          /*!< Returns size of the mapping in bytes */
+
+private:
+    /**
+     *    \fn           bool indexNextBlock()
+     *    \brief        Builds structural index of the block starting at the next line
+     *    \return       Boolean value determining if the block contains at least one complete line
+     */
+    bool indexNextBlock();
+
+    const char* m_data;     /*!< Beginning of the mapping */
+    size_t m_size;          /*!< Size of the mapping in bytes */
+    size_t m_position;      /*!< Offset of the next line to be read */
+    bool m_isOpen;          /*!< Mapping state */
+    bool m_ownsMapping;     /*!< Determines if mapping is released by this reader */
+    StructuralIndex m_index; /*!< Structural characters of the currently indexed block */
+    size_t m_indexBase;     /*!< Offset of the currently indexed block */
+    size_t m_indexEnd;      /*!< Offset of the end of the currently indexed block */
+    size_t m_indexPos;      /*!< Next unread entry of the structural index */
+#ifdef _WIN32
+    void* m_fileHandle;     /*!< Handle of the mapped file */
+    void* m_mappingHandle;  /*!< Handle of the file mapping object */
+#else
+    int m_fileDescriptor;   /*!< Descriptor of the mapped file */
+#endif
+};
+
 /**
  *    \fn           void splitElementsOfAISMessage(string& AISString, AISMessage& AISMsg)
  *    \brief        Splits comma separated elements of AIS message
@@ -54,6 +201,18 @@ struct lineContent {
  */
 void splitElementsOfAISMessage(string& AISString, AISMessage& AISMsg);
 
+/**
+ *    \fn           AISParseStatus splitElementsOfAISMessage(string_view AISString, AISMessageView& AISMsg)
+ *    \brief        Splits comma separated elements of AIS message without copying them
+ *    \param[in]    AISString
+ *                    AIS message string
+ *    \param[out]    AISMsg
+ *                    Structure for storing views of extracted substrings
+ *    \return       Status of the operation
+ *    \note         Separators are located in a single pass over the message and no memory is allocated
+ */
+AISParseStatus splitElementsOfAISMessage(string_view AISString, AISMessageView& AISMsg);
+
 /**
  *    \fn           bool readLineFromFile(lineContent& line, ifstream& file_reader)
  *    \brief        Main program performing AIS messages processing
@@ -67,4 +226,17 @@ void splitElementsOfAISMessage(string& AISString, AISMessage& AISMsg);
  */
 bool readLineFromFile(lineContent& line, ifstream& file_reader);
 
+/**
+ *    \fn           bool readLineFromFile(lineView& line, MappedFileReader& file_reader)
+ *    \brief        Reads next line of memory mapped file without copying its content
+ *    \param[out]    line
+ *                    Structure for storing views of line components
+ *    \param[in]    file_reader
+ *                    Reader used for file reading
+ *    \return       Boolean value determining if reading was successful
+ *    \note         Return value can be used to detect EOF
+ *    \warning      Reader must be opened before being passed to the function
+ */
+bool readLineFromFile(lineView& line, MappedFileReader& file_reader);
+
 #endif /* read_hpp */
@@ -0,0 +1,206 @@
+/**
+ * \file reassembly.cpp
+ *
+ * \brief Joining of multi-sentence messages.
+ *
+ * \details This file includes definitions of functions used for joining payloads of AIS messages split into several sentences.
+ *
+ * \date    16/10/2026
+ */
+
+#include <cstring>
+#include <algorithm>
+#include "reassembly.hpp"
+#include "filter.hpp"
+
+/**
+ *    \fn           bool parseSentenceNumber(string_view text, unsigned& number)
+ *    \brief        Converts single-digit sentence count or number
+ *    \param[in]    text
+ *                    Element of the sentence
+ *    \param[out]    number
+ *                    Converted number
+ *    \return       Boolean value determining if element is a digit from 1 to 9
+ */
+static inline bool parseSentenceNumber(string_view text, unsigned& number)
+{
+    if (text.size() != 1 || text[0] < '1' || text[0] > '9') return false;
+    number = static_cast<unsigned>(text[0] - '0');
+    return true;
+}
+
+/**
+ *    \fn           unsigned slotIndex(const AISMessageView& AISMsg)
+ *    \brief        Maps sequence ID and channel of the sentence to a slot of the reassembly table
+ *    \param[in]    AISMsg
+ *                    Elements of the sentence
+ *    \return       Index of the slot
+ */
+static inline unsigned slotIndex(const AISMessageView& AISMsg)
+{
+    // Sequence ID is a single digit, messages without it share one more row
+    unsigned seqID = (AISMsg.seqID.size() == 1 && AISMsg.seqID[0] >= '0' && AISMsg.seqID[0] <= '9')
+                     ? static_cast<unsigned>(AISMsg.seqID[0] - '0') : 10;
+
+    // Channels are called either A/B or 1/2
+    unsigned channel = 3;
+    if (AISMsg.channel.empty()) channel = 2;
+    else if (AISMsg.channel.size() == 1) {
+        if (AISMsg.channel[0] == 'A' || AISMsg.channel[0] == '1') channel = 0;
+        else if (AISMsg.channel[0] == 'B' || AISMsg.channel[0] == '2') channel = 1;
+    }
+    return seqID*4 + channel;
+}
+
+FragmentReassembler::FragmentReassembler(uint32_t types)
+: m_types(types), m_activeCnt(0), m_droppedCnt(0), m_countBegin(0), m_nextEviction(0)
+{
+}
+
+/**
+ *    \fn           void FragmentReassembler::release(Slot& slot)
+ *    \brief        Frees slot without counting its message as dropped
+ *    \param[in,out] slot
+ *                    Slot of the message
+ */
+void FragmentReassembler::release(Slot& slot)
+{
+    if (!slot.active) return;
+    slot.active = false;
+    m_activeCnt--;
+}
+
+/**
+ *    \fn           void FragmentReassembler::drop(Slot& slot, size_t lineNum)
+ *    \brief        Drops unfinished message
+ *    \param[in,out] slot
+ *                    Slot of the message
+ *    \param[in]    lineNum
+ *                    Number of the line at which message is dropped
+ */
+void FragmentReassembler::drop(Slot& slot, size_t lineNum)
+{
+    if (!slot.active) return;
+    release(slot);
+    if (lineNum >= m_countBegin) m_droppedCnt++;
+}
+
+/**
+ *    \fn           void FragmentReassembler::evictExpired(size_t lineNum)
+ *    \brief        Drops messages which have not received a sentence for too long
+ *    \param[in]    lineNum
+ *                    Number of the current line
+ */
+void FragmentReassembler::evictExpired(size_t lineNum)
+{
+    for (Slot& slot : m_slots) {
+        if (slot.active && lineNum >= expiryLine(slot)) drop(slot, expiryLine(slot));
+    }
+}
+
+/**
+ *    \fn           FragmentStatus FragmentReassembler::add(const AISMessageView& AISMsg, size_t lineNum, string_view& payload)
+ *    \brief        Adds sentence of a multi-sentence message
+ *    \param[in]    AISMsg
+ *                    Elements of the sentence
+ *    \param[in]    lineNum
+ *                    Number of the line containing the sentence (used for timeouts)
+ *    \param[out]    payload
+ *                    Joined payload of the message, valid until the next call
+ *    \return       Status of the message
+ *    \note         Stored message which cannot be completed because of the sentence is included in
+ *                  droppedCnt(). Sentences following the first one of a message without a slot are
+ *                  skipped without counting, as the type of their message is unknown.
+ */
+FragmentStatus FragmentReassembler::add(const AISMessageView& AISMsg, size_t lineNum, string_view& payload)
+{
+    // Check timeouts only once in a while, so that single sentence costs O(1)
+    if (m_activeCnt > 0 && lineNum >= m_nextEviction) {
+        evictExpired(lineNum);
+        m_nextEviction = lineNum + REASSEMBLY_TIMEOUT_LINES;
+    }
+
+    unsigned sentenceCnt, sentenceNum;
+    if (!parseSentenceNumber(AISMsg.msgCnt, sentenceCnt) || !parseSentenceNumber(AISMsg.msgNum, sentenceNum) ||
+        sentenceNum > sentenceCnt) {
+        return FRAGMENT_INVALID;
+    }
+
+    // Message which has timed out is dropped at the line of its timeout, whenever the check happens
+    Slot& slot = m_slots[slotIndex(AISMsg)];
+    if (slot.active && lineNum >= expiryLine(slot)) drop(slot, expiryLine(slot));
+    if (sentenceNum == 1) {
+
+        // First sentence replaces unfinished message using the same sequence ID
+        drop(slot, lineNum);
+
+        // Type is held by the first character, messages which are not decoded do not take a slot
+        unsigned type;
+        if (!extractArmored<CommonHeaderSchema::MessageType>(AISMsg.payload, type)) return FRAGMENT_INVALID;
+        if (type >= 32 || (m_types & (1u << type)) == 0) return FRAGMENT_SKIPPED;
+        slot.active = true;
+        slot.sentenceCnt = sentenceCnt;
+        slot.len = 0;
+        m_activeCnt++;
+    }
+    else if (!slot.active) {
+        return FRAGMENT_SKIPPED;
+    }
+    else if (slot.sentenceCnt != sentenceCnt || slot.nextSentence != sentenceNum) {
+
+        // Sentence does not continue the stored message, neither of them can be completed
+        drop(slot, lineNum);
+        return FRAGMENT_SKIPPED;
+    }
+
+    if (slot.len + AISMsg.payload.size() > REASSEMBLY_MAX_CHARS) {
+        drop(slot, lineNum);
+        return FRAGMENT_SKIPPED;
+    }
+    memcpy(slot.chars + slot.len, AISMsg.payload.data(), AISMsg.payload.size());
+    slot.len += AISMsg.payload.size();
+    slot.nextSentence = sentenceNum + 1;
+    slot.lastLine = lineNum;
+
+    if (sentenceNum < sentenceCnt) return FRAGMENT_PENDING;
+
+    // Message is complete, slot is released but its characters stay valid until the next call
+    slot.active = false;
+    m_activeCnt--;
+    payload = string_view(slot.chars, slot.len);
+    return FRAGMENT_COMPLETE;
+}
+
+/**
+ *    \fn           void FragmentReassembler::reset(size_t countBegin)
+ *    \brief        Forgets all unfinished messages without counting them
+ *    \param[in]    countBegin
+ *                    Number of the first line whose dropped messages are counted (lines before it
+ *                    only restore unfinished messages)
+ */
+void FragmentReassembler::reset(size_t countBegin)
+{
+    for (Slot& slot : m_slots) slot.active = false;
+    m_activeCnt = 0;
+    m_countBegin = countBegin;
+    m_nextEviction = 0;
+}
+
+/**
+ *    \fn           void FragmentReassembler::finish(size_t lineNum, bool last)
+ *    \brief        Ends the processed part of the input
+ *    \param[in]    lineNum
+ *                    Number of the line following the part
+ *    \param[in]    last
+ *                    Determines if the part ends the input
+ *    \note         Unfinished messages are counted as dropped only if they time out within the
+ *                  part or the part is the last one, others are left to the next part
+ */
+void FragmentReassembler::finish(size_t lineNum, bool last)
+{
+    for (Slot& slot : m_slots) {
+        if (!slot.active) continue;
+        if (last || expiryLine(slot) < lineNum) drop(slot, std::min(expiryLine(slot), lineNum));
+        else release(slot);
+    }
+}
@@ -0,0 +1,169 @@
+/**
+ * \file reassembly.hpp
+ *
+ * \brief Header file of 'reassembly.cpp'.
+ *
+ * \details This file includes declarations of structures and functions used for joining payloads of AIS messages split into several sentences.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef reassembly_hpp
+#define reassembly_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include "read.hpp"
+
+using std::string_view;
+
+//! Maximal number of payload characters of a joined message (1008 bits, the longest 5-slot message; type 5 needs 71 characters)
+#define REASSEMBLY_MAX_CHARS 168
+//! Number of lines after which unfinished message is dropped
+#define REASSEMBLY_TIMEOUT_LINES 64
+//! Number of lines preceding a part of the input which may hold sentences of its unfinished messages (9 sentences, each within the timeout)
+#define REASSEMBLY_WINDOW_LINES (9*REASSEMBLY_TIMEOUT_LINES + 1)
+//! Number of slots of the reassembly table: 10 sequence IDs and a missing one, times 4 channel codes
+#define REASSEMBLY_SLOT_NUM 44
+
+/**
+ *    \enum         FragmentStatus
+ *    \brief        Result of adding a sentence to the reassembly table
+ */
+enum FragmentStatus {
+    FRAGMENT_COMPLETE = 0,  /*!< Sentence completed the message, joined payload is available */
+    FRAGMENT_PENDING,       /*!< Sentence was stored, further sentences are expected */
+    FRAGMENT_SKIPPED,       /*!< Sentence belongs to a message which is not decoded or cannot be completed */
+    FRAGMENT_INVALID        /*!< Sentence numbering or message type is malformed */
+};
+
+/**
+ *    \class        FragmentReassembler
+ *    \brief        Table joining payloads of multi-sentence messages
+ *    \details      Unfinished messages are kept in a fixed table of slots indexed directly by
+ *                  sequence ID and channel, so adding a sentence costs O(1) and never allocates.
+ *                  Sentences of a message must arrive in order. Message whose next sentence does
+ *                  not arrive within REASSEMBLY_TIMEOUT_LINES lines is dropped. Messages of types
+ *                  which are not decoded never take a slot, so they can neither be counted as
+ *                  incomplete nor replace messages which are decoded.
+ *
+ *                  Parts of the input can be processed separately: sentences of the
+ *                  REASSEMBLY_WINDOW_LINES lines preceding a part restore its unfinished messages
+ *                  exactly, and every dropped message is counted by the part holding the line at
+ *                  which it is dropped, so results do not depend on where the input is split.
+ */
+class FragmentReassembler {
+public:
+    /**
+     *    \fn           FragmentReassembler(uint32_t types)
+     *    \brief        Creates empty reassembly table
+     *    \param[in]    types
+     *                    Bit mask of decoded message types (bit n selects type n)
+     */
+    explicit FragmentReassembler(uint32_t types);
+
+    /**
+     *    \fn           FragmentStatus add(const AISMessageView& AISMsg, size_t lineNum, string_view& payload)
+     *    \brief        Adds sentence of a multi-sentence message
+     *    \param[in]    AISMsg
+     *                    Elements of the sentence
+     *    \param[in]    lineNum
+     *                    Number of the line containing the sentence (used for timeouts)
+     *    \param[out]    payload
+     *                    Joined payload of the message, valid until the next call
+     *    \return       Status of the message
+     *    \note         Stored message which cannot be completed because of the sentence is included in
+     *                  droppedCnt(). Sentences following the first one of a message without a slot are
+     *                  skipped without counting, as the type of their message is unknown.
+     */
+    FragmentStatus add(const AISMessageView& AISMsg, size_t lineNum, string_view& payload);
+    /**
+     *    \fn           void reset(size_t countBegin)
+     *    \brief        Forgets all unfinished messages without counting them
+     *    \param[in]    countBegin
+     *                    Number of the first line whose dropped messages are counted (lines before it
+     *                    only restore unfinished messages)
+     */
+    void reset(size_t countBegin);
+    /**
+     *    \fn           void finish(size_t lineNum, bool last)
+     *    \brief        Ends the processed part of the input
+     *    \param[in]    lineNum
+     *                    Number of the line following the part
+     *    \param[in]    last
+     *                    Determines if the part ends the input
+     *    \note         Unfinished messages are counted as dropped only if they time out within the
+     *                  part or the part is the last one, others are left to the next part
+     */
+    void finish(size_t lineNum, bool last);
+    /**
+     *    \fn           size_t droppedCnt() const
+     *    \brief        Returns number of unfinished messages dropped after timeout, replaced by a message with the same sequence ID or broken by a sentence not continuing them
+     */
+    size_t droppedCnt() const { return m_droppedCnt; }
+
+private:
+    /**
+     *    \struct       Slot
+     *    \brief        Unfinished message
+     */
+    struct Slot {
+        bool active = false;                /*!< Determines if slot holds unfinished message */
+        unsigned sentenceCnt = 0;           /*!< Number of sentences of the message */
+        unsigned nextSentence = 0;          /*!< Number of the expected sentence */
+        size_t lastLine = 0;                /*!< Number of the line of the last stored sentence */
+        size_t len = 0;                     /*!< Number of stored payload characters */
+        char chars[REASSEMBLY_MAX_CHARS];   /*!< Payload characters of stored sentences */
+    };
+
+    /**
+     *    \fn           void release(Slot& slot)
+     *    \brief        Frees slot without counting its message as dropped
+     *    \param[in,out] slot
+     *                    Slot of the message
+     */
+    void release(Slot& slot);
+    /**
+     *    \fn           void drop(Slot& slot, size_t lineNum)
+     *    \brief        Drops unfinished message
+     *    \param[in,out] slot
+     *                    Slot of the message
+     *    \param[in]    lineNum
+     *                    Number of the line at which message is dropped
+     */
+    void drop(Slot& slot, size_t lineNum);
+    /**
+     *    \fn           size_t expiryLine(const Slot& slot)
+     *    \brief        Returns number of the first line at which unfinished message is timed out
+     */
+    static size_t expiryLine(const Slot& slot) { return slot.lastLine + REASSEMBLY_TIMEOUT_LINES + 1; }
+    /**
+     *    \fn           void evictExpired(size_t lineNum)
+     *    \brief        Drops messages which have not received a sentence for too long
+     *    \param[in]    lineNum
+     *                    Number of the current line
+     */
+    void evictExpired(size_t lineNum);
+
+    Slot m_slots[REASSEMBLY_SLOT_NUM];  /*!< Table of unfinished messages */
+    uint32_t m_types;                   /*!< Bit mask of decoded message types */
+    size_t m_activeCnt;                 /*!< Number of unfinished messages */
+    size_t m_droppedCnt;                /*!< Number of dropped messages */
+    size_t m_countBegin;                /*!< Number of the first line whose dropped messages are counted */
+    size_t m_nextEviction;              /*!< Number of the line of the next timeout check */
+};
+
+/**
+ *    \fn           bool isMultipart(const AISMessageView& AISMsg)
+ *    \brief        Checks if sentence is a part of a message split into several sentences
+ *    \param[in]    AISMsg
+ *                    Elements of the sentence
+ *    \return       Boolean value determining if the message consists of more than one sentence
+ */
+inline bool isMultipart(const AISMessageView& AISMsg)
+{
+    return !(AISMsg.msgCnt.size() == 1 && AISMsg.msgCnt[0] == '1');
+}
+
+#endif /* reassembly_hpp */
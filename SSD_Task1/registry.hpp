@@ -0,0 +1,147 @@
+/**
+ * \file registry.hpp
+ *
+ * \brief Hash table indexed by MMSI numbers.
+ *
+ * \details This file includes definition of open addressing hash table storing per-vessel state under 30-bit MMSI numbers.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef registry_hpp
+#define registry_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using std::vector;
+
+//! Key marking empty slot of MMSIMap (MMSI numbers have only 30 bits)
+#define MMSI_MAP_EMPTY_KEY 0xFFFFFFFFu
+//! Index returned by MMSIMap::find for MMSI numbers not present in the map
+#define MMSI_MAP_NOT_FOUND 0xFFFFFFFFu
+
+/**
+ *    \class        MMSIMap
+ *    \brief        Open addressing hash table mapping MMSI numbers to per-vessel values
+ *    \details      Values are stored densely in insertion order and keep their indices for the
+ *                  whole lifetime of the map, so they can be linked with each other by index.
+ *                  Slots are probed linearly and the table is doubled when it gets half full.
+ *    \tparam       T
+ *                    Type of stored values
+ */
+template <class T>
+class MMSIMap {
+public:
+    /**
+     *    \fn           MMSIMap(size_t initialCapacity)
+     *    \brief        Creates empty map
+     *    \param[in]    initialCapacity
+     *                    Expected number of vessels
+     */
+    explicit MMSIMap(size_t initialCapacity = 1024)
+    {
+        size_t slotCnt = 16;
+        while (slotCnt < 2*initialCapacity) slotCnt *= 2;
+        m_slots.assign(slotCnt, Slot{MMSI_MAP_EMPTY_KEY, 0});
+        m_values.reserve(initialCapacity);
+    }
+
+    /**
+     *    \fn           uint32_t find(unsigned MMSI) const
+     *    \brief        Looks up MMSI number
+     *    \param[in]    MMSI
+     *                    MMSI number of the vessel
+     *    \return       Index of the vessel's value or MMSI_MAP_NOT_FOUND
+     */
+    uint32_t find(unsigned MMSI) const
+    {
+        size_t mask = m_slots.size() - 1;
+        for (size_t pos = hash(MMSI) & mask; ; pos = (pos + 1) & mask) {
+            if (m_slots[pos].key == MMSI) return m_slots[pos].index;
+            if (m_slots[pos].key == MMSI_MAP_EMPTY_KEY) return MMSI_MAP_NOT_FOUND;
+        }
+    }
+
+    /**
+     *    \fn           uint32_t insert(unsigned MMSI, bool& inserted)
+     *    \brief        Looks up MMSI number and adds default constructed value if it is not present
+     *    \param[in]    MMSI
+     *                    MMSI number of the vessel
+     *    \param[out]    inserted
+     *                    Determines if new value was added
+     *    \return       Index of the vessel's value
+     */
+    uint32_t insert(unsigned MMSI, bool& inserted)
+    {
+        size_t mask = m_slots.size() - 1;
+        size_t pos = hash(MMSI) & mask;
+        for (; m_slots[pos].key != MMSI_MAP_EMPTY_KEY; pos = (pos + 1) & mask) {
+            if (m_slots[pos].key == MMSI) {
+                inserted = false;
+                return m_slots[pos].index;
+            }
+        }
+
+        uint32_t index = static_cast<uint32_t>(m_values.size());
+        m_values.emplace_back();
+        m_keys.push_back(MMSI);
+        m_slots[pos] = Slot{MMSI, index};
+        if (2*m_values.size() > m_slots.size()) grow();
+
+        inserted = true;
+        return index;
+    }
+
+    T& operator[](uint32_t index) { return m_values[index]; }               /*!< Returns value of given index */
+    const T& operator[](uint32_t index) const { return m_values[index]; }   /*!< Returns value of given index */
+    unsigned keyAt(uint32_t index) const { return m_keys[index]; }          /*!< Returns MMSI number of given index */
+    size_t size() const { return m_values.size(); }                         /*!< Returns number of vessels */
+
+private:
+    /**
+     *    \struct       Slot
+     *    \brief        Entry of the hash table
+     */
+    struct Slot {
+        uint32_t key;       /*!< MMSI number or MMSI_MAP_EMPTY_KEY */
+        uint32_t index;     /*!< Index of the value */
+    };
+
+    /**
+     *    \fn           static size_t hash(unsigned MMSI)
+     *    \brief        Scatters MMSI numbers over the table
+     *    \param[in]    MMSI
+     *                    MMSI number of the vessel
+     *    \return       Hash value
+     */
+    static size_t hash(unsigned MMSI)
+    {
+        // MMSI numbers of one country share leading digits, mix all bits of the key
+        uint64_t h = static_cast<uint64_t>(MMSI) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(h >> 32);
+    }
+
+    /**
+     *    \fn           void grow()
+     *    \brief        Doubles number of slots and reinserts all keys
+     */
+    void grow()
+    {
+        vector<Slot> slots(2*m_slots.size(), Slot{MMSI_MAP_EMPTY_KEY, 0});
+        size_t mask = slots.size() - 1;
+        for (uint32_t index = 0; index < m_keys.size(); index++) {
+            size_t pos = hash(m_keys[index]) & mask;
+            while (slots[pos].key != MMSI_MAP_EMPTY_KEY) pos = (pos + 1) & mask;
+            slots[pos] = Slot{m_keys[index], index};
+        }
+        m_slots.swap(slots);
+    }
+
+    vector<Slot> m_slots;   /*!< Hash table, number of slots is a power of 2 */
+    vector<unsigned> m_keys; /*!< MMSI numbers in insertion order */
+    vector<T> m_values;     /*!< Values in insertion order */
+};
+
+#endif /* registry_hpp */
@@ -0,0 +1,177 @@
+/**
+ * \file report.cpp
+ *
+ * \brief Functions for decoding numeric content of AIS messages.
+ *
+ * \details This file includes definitions of functions decoding AIS messages in binary format into structures of fixed-point values, independently of their textual representation.
+ *
+ * \date    16/10/2026
+ */
+
+#include <cstddef>
+#include "report.hpp"
+#include "schema.hpp"
+
+/**
+ *    \fn           void decodePositionReport(const byte* msg, PositionReport& report)
+ *    \brief        Decodes all fields of Position Report Class A in a single call
+ *    \param[in]    msg
+ *                    AIS message in binary format
+ *    \param[out]    report
+ *                    Structure for storing decoded values
+ *    \note         Adjacent fields are extracted in groups sharing a single load
+ */
+void decodePositionReport(const byte* msg, PositionReport& report)
+{
+    typedef PositionReportSchema S;
+    unsigned messageType, repeatIndicator, MMSI, status;
+    int rateOfTurn;
+    unsigned speedOverGround, positionAccuracy;
+    int longitude, latitude;
+    unsigned courseOverGround;
+    unsigned trueHeading, timeStamp, maneuver, RAIMFlag, radioStatus;
+    
+    // Bits 0-49
+    FieldGroup<S::MessageType, S::RepeatIndicator, S::MMSI, S::NavigationStatus, S::RateOfTurn>
+        ::extract(msg, messageType, repeatIndicator, MMSI, status, rateOfTurn);
+    // Bits 50-88
+    FieldGroup<S::SpeedOverGround, S::PositionAccuracy, S::Longitude>
+        ::extract(msg, speedOverGround, positionAccuracy, longitude);
+    // Bits 89-127
+    FieldGroup<S::Latitude, S::CourseOverGround>
+        ::extract(msg, latitude, courseOverGround);
+    // Bits 128-167
+    FieldGroup<S::TrueHeading, S::TimeStamp, S::ManeuverIndicator, S::RAIMFlag, S::RadioStatus>
+        ::extract(msg, trueHeading, timeStamp, maneuver, RAIMFlag, radioStatus);
+    
+    report.messageType = static_cast<byte>(messageType);
+    report.repeatIndicator = static_cast<byte>(repeatIndicator);
+    report.MMSI = MMSI;
+    report.status = static_cast<NavigationStatusCode>(status);
+    report.rateOfTurn = static_cast<signed char>(rateOfTurn);
+    report.speedOverGround = static_cast<unsigned short>(speedOverGround);
+    report.positionAccuracy = static_cast<byte>(positionAccuracy);
+    report.longitude = longitude;
+    report.latitude = latitude;
+    report.courseOverGround = static_cast<unsigned short>(courseOverGround);
+    report.trueHeading = static_cast<unsigned short>(trueHeading);
+    report.timeStamp = static_cast<byte>(timeStamp);
+    report.maneuver = static_cast<ManeuverIndicatorCode>(maneuver);
+    report.RAIMFlag = static_cast<byte>(RAIMFlag);
+    report.radioStatus = radioStatus;
+}
+
+/**
+ *    \fn           void decodePositionReport(const byte* msg, PositionReport& report, uint32_t fields)
+ *    \brief        Decodes selected fields of Position Report Class A
+ *    \param[in]    msg
+ *                    AIS message in binary format
+ *    \param[out]    report
+ *                    Structure for storing decoded values (unselected fields are left unchanged)
+ *    \param[in]    fields
+ *                    Mask of ReportField bits
+ *    \note         Groups of fields sharing a single load are skipped when none of their fields is
+ *                  selected. The first group (message type to rate of turn) holds MMSI, so it is
+ *                  always decoded.
+ */
+void decodePositionReport(const byte* msg, PositionReport& report, uint32_t fields)
+{
+    typedef PositionReportSchema S;
+    
+    // Bits 0-49, MMSI is needed for choosing the output file
+    unsigned messageType, repeatIndicator, MMSI, status;
+    int rateOfTurn;
+    FieldGroup<S::MessageType, S::RepeatIndicator, S::MMSI, S::NavigationStatus, S::RateOfTurn>
+        ::extract(msg, messageType, repeatIndicator, MMSI, status, rateOfTurn);
+    report.messageType = static_cast<byte>(messageType);
+    report.repeatIndicator = static_cast<byte>(repeatIndicator);
+    report.MMSI = MMSI;
+    report.status = static_cast<NavigationStatusCode>(status);
+    report.rateOfTurn = static_cast<signed char>(rateOfTurn);
+    
+    // Bits 50-88
+    if (fields & (REPORT_FIELD_SOG | REPORT_FIELD_ACCURACY | REPORT_FIELD_LON)) {
+        unsigned speedOverGround, positionAccuracy;
+        int longitude;
+        FieldGroup<S::SpeedOverGround, S::PositionAccuracy, S::Longitude>
+            ::extract(msg, speedOverGround, positionAccuracy, longitude);
+        report.speedOverGround = static_cast<unsigned short>(speedOverGround);
+        report.positionAccuracy = static_cast<byte>(positionAccuracy);
+        report.longitude = longitude;
+    }
+    
+    // Bits 89-127
+    if (fields & (REPORT_FIELD_LAT | REPORT_FIELD_COG)) {
+        int latitude;
+        unsigned courseOverGround;
+        FieldGroup<S::Latitude, S::CourseOverGround>
+            ::extract(msg, latitude, courseOverGround);
+        report.latitude = latitude;
+        report.courseOverGround = static_cast<unsigned short>(courseOverGround);
+    }
+    
+    // Bits 128-144, RAIM flag and radio status are not written to the output
+    if (fields & (REPORT_FIELD_HDG | REPORT_FIELD_TIMESTAMP | REPORT_FIELD_MANEUVER)) {
+        unsigned trueHeading, timeStamp, maneuver;
+        FieldGroup<S::TrueHeading, S::TimeStamp, S::ManeuverIndicator>
+            ::extract(msg, trueHeading, timeStamp, maneuver);
+        report.trueHeading = static_cast<unsigned short>(trueHeading);
+        report.timeStamp = static_cast<byte>(timeStamp);
+        report.maneuver = static_cast<ManeuverIndicatorCode>(maneuver);
+    }
+}
+
+/**
+ *    \struct       ReportFieldName
+ *    \brief        Name of output field accepted in the command line
+ */
+struct ReportFieldName {
+    const char* name;   /*!< Name in lower case */
+    uint32_t field;     /*!< ReportField bit */
+};
+
+/**
+ *    \var      const ReportFieldName ReportFieldNames[]
+ *    \brief    Names of all output fields
+ */
+static const ReportFieldName ReportFieldNames[] = {
+    {"time", REPORT_FIELD_TIME}, {"type", REPORT_FIELD_TYPE}, {"count", REPORT_FIELD_COUNT},
+    {"mmsi", REPORT_FIELD_MMSI}, {"status", REPORT_FIELD_STATUS}, {"rot", REPORT_FIELD_ROT},
+    {"sog", REPORT_FIELD_SOG}, {"accuracy", REPORT_FIELD_ACCURACY}, {"lon", REPORT_FIELD_LON},
+    {"lat", REPORT_FIELD_LAT}, {"cog", REPORT_FIELD_COG}, {"hdg", REPORT_FIELD_HDG},
+    {"timestamp", REPORT_FIELD_TIMESTAMP}, {"maneuver", REPORT_FIELD_MANEUVER}
+};
+
+/**
+ *    \fn           bool parseReportFields(const char* list, uint32_t& fields)
+ *    \brief        Converts names of output fields to mask of ReportField bits
+ *    \param[in]    list
+ *                    Comma separated names (time, type, count, mmsi, status, rot, sog, accuracy,
+ *                    lon, lat, cog, hdg, timestamp, maneuver), letter case is ignored
+ *    \param[out]    fields
+ *                    Mask of selected fields
+ *    \return       Boolean value determining if all names are valid and at least one is given
+ */
+bool parseReportFields(const char* list, uint32_t& fields)
+{
+    uint32_t selected = 0;
+    while (*list != '\0') {
+        const char* end = list;
+        while (*end != '\0' && *end != ',') end++;
+        
+        // Compare the name with all known names ignoring letter case
+        uint32_t field = 0;
+        for (const ReportFieldName& known : ReportFieldNames) {
+            size_t i = 0;
+            while (list + i < end && known.name[i] != '\0' && (list[i] | 0x20) == known.name[i]) i++;
+            if (list + i == end && known.name[i] == '\0') field = known.field;
+        }
+        if (field == 0) return false;
+        selected |= field;
+        
+        list = (*end == ',') ? end + 1 : end;
+    }
+    if (selected == 0) return false;
+    fields = selected;
+    return true;
+}
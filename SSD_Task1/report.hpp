@@ -0,0 +1,131 @@
+/**
+ * \file report.hpp
+ *
+ * \brief Header file of 'report.cpp'.
+ *
+ * \details This file includes definitions of structures holding decoded numeric content of AIS messages and declarations of functions producing them.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef report_hpp
+#define report_hpp
+
+#include <cstdint>
+#include "main.hpp"
+
+//! Mask selecting all fields of the output record
+#define REPORT_FIELDS_ALL 0x3FFFu
+
+/**
+ *    \enum         NavigationStatusCode
+ *    \brief        Values of 'Navigation Status' parameter
+ */
+enum NavigationStatusCode : byte {
+    NAV_UNDER_WAY_USING_ENGINE = 0,     /*!< Under way using engine */
+    NAV_AT_ANCHOR = 1,                  /*!< At anchor */
+    NAV_NOT_UNDER_COMMAND = 2,          /*!< Not under command */
+    NAV_RESTRICTED_MANOEUVERABILITY = 3, /*!< Restricted manoeuverability */
+    NAV_CONSTRAINED_BY_DRAUGHT = 4,     /*!< Constrained by her draught */
+    NAV_MOORED = 5,                     /*!< Moored */
+    NAV_AGROUND = 6,                    /*!< Aground */
+    NAV_ENGAGED_IN_FISHING = 7,         /*!< Engaged in fishing */
+    NAV_UNDER_WAY_SAILING = 8,          /*!< Under way sailing */
+    NAV_AIS_SART_ACTIVE = 14,           /*!< AIS-SART is active */
+    NAV_NOT_DEFINED = 15                /*!< Not defined (values 9-13 are reserved) */
+};
+
+/**
+ *    \enum         ManeuverIndicatorCode
+ *    \brief        Values of 'Maneuver Indicator' parameter
+ */
+enum ManeuverIndicatorCode : byte {
+    MANEUVER_NOT_AVAILABLE = 0,         /*!< Not available */
+    MANEUVER_NO_SPECIAL = 1,            /*!< No special maneuver */
+    MANEUVER_SPECIAL = 2                /*!< Special maneuver (value 3 is reserved) */
+};
+
+/**
+ *    \enum         ReportField
+ *    \brief        Bits of mask selecting fields of the output record
+ */
+enum ReportField : uint32_t {
+    REPORT_FIELD_TIME = 1u << 0,        /*!< Date and time of reception */
+    REPORT_FIELD_TYPE = 1u << 1,        /*!< Message Type */
+    REPORT_FIELD_COUNT = 1u << 2,       /*!< Repeat Indicator */
+    REPORT_FIELD_MMSI = 1u << 3,        /*!< MMSI */
+    REPORT_FIELD_STATUS = 1u << 4,      /*!< Navigation Status */
+    REPORT_FIELD_ROT = 1u << 5,         /*!< Rate Of Turn */
+    REPORT_FIELD_SOG = 1u << 6,         /*!< Speed Over Ground */
+    REPORT_FIELD_ACCURACY = 1u << 7,    /*!< Position Accuracy */
+    REPORT_FIELD_LON = 1u << 8,         /*!< Longitude */
+    REPORT_FIELD_LAT = 1u << 9,         /*!< Latitude */
+    REPORT_FIELD_COG = 1u << 10,        /*!< Course Over Ground */
+    REPORT_FIELD_HDG = 1u << 11,        /*!< True Heading */
+    REPORT_FIELD_TIMESTAMP = 1u << 12,  /*!< Time Stamp */
+    REPORT_FIELD_MANEUVER = 1u << 13    /*!< Maneuver Indicator */
+};
+
+/**
+ *    \struct       PositionReport
+ *    \brief        Structure for storing decoded Position Report Class A (types 1, 2 and 3)
+ *    \details      All values are kept in fixed-point units used by the AIVDM protocol, special
+ *                  values (e.g. 'not available') are stored unchanged.
+ */
+struct PositionReport {
+    byte messageType;                   /*!< Message Type */
+    byte repeatIndicator;               /*!< Repeat Indicator */
+    unsigned MMSI;                      /*!< MMSI */
+    NavigationStatusCode status;        /*!< Navigation Status */
+    signed char rateOfTurn;             /*!< Rate Of Turn (raw AIS value, -128 if not available) */
+    unsigned short speedOverGround;     /*!< Speed Over Ground [0.1 knot] (1023 if not available) */
+    byte positionAccuracy;              /*!< Position Accuracy */
+    int longitude;                      /*!< Longitude [1/10000 min] (181 deg if not available) */
+    int latitude;                       /*!< Latitude [1/10000 min] (91 deg if not available) */
+    unsigned short courseOverGround;    /*!< Course Over Ground [0.1 deg] (3600 if not available) */
+    unsigned short trueHeading;         /*!< True Heading [deg] (511 if not available) */
+    byte timeStamp;                     /*!< Time Stamp [s] (60-63 for special values) */
+    ManeuverIndicatorCode maneuver;     /*!< Maneuver Indicator */
+    byte RAIMFlag;                      /*!< RAIM Flag */
+    unsigned radioStatus;               /*!< Radio Status */
+};
+
+/**
+ *    \fn           void decodePositionReport(const byte* msg, PositionReport& report)
+ *    \brief        Decodes all fields of Position Report Class A in a single call
+ *    \param[in]    msg
+ *                    AIS message in binary format
+ *    \param[out]    report
+ *                    Structure for storing decoded values
+ *    \note         Adjacent fields are extracted in groups sharing a single load
+ */
+void decodePositionReport(const byte* msg, PositionReport& report);
+
+/**
+ *    \fn           void decodePositionReport(const byte* msg, PositionReport& report, uint32_t fields)
+ *    \brief        Decodes selected fields of Position Report Class A
+ *    \param[in]    msg
+ *                    AIS message in binary format
+ *    \param[out]    report
+ *                    Structure for storing decoded values (unselected fields are left unchanged)
+ *    \param[in]    fields
+ *                    Mask of ReportField bits
+ *    \note         Groups of fields sharing a single load are skipped when none of their fields is
+ *                  selected. The first group (message type to rate of turn) holds MMSI, so it is
+ *                  always decoded.
+ */
+void decodePositionReport(const byte* msg, PositionReport& report, uint32_t fields);
+
+/**
+ *    \fn           bool parseReportFields(const char* list, uint32_t& fields)
+ *    \brief        Converts names of output fields to mask of ReportField bits
+ *    \param[in]    list
+ *                    Comma separated names (time, type, count, mmsi, status, rot, sog, accuracy,
+ *                    lon, lat, cog, hdg, timestamp, maneuver), letter case is ignored
+ *    \param[out]    fields
+ *                    Mask of selected fields
+ *    \return       Boolean value determining if all names are valid and at least one is given
+ */
+bool parseReportFields(const char* list, uint32_t& fields);
+
+#endif /* report_hpp */
@@ -0,0 +1,183 @@
+/**
+ * \file ring.cpp
+ *
+ * \brief Ring buffer for passing records between threads.
+ *
+ * \details This file includes definitions of functions of lock-free single-producer/single-consumer ring buffer carrying output records between threads.
+ *
+ * \date    16/10/2026
+ */
+
+#include <cstring>
+#include <thread>
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_IX86)
+#include <emmintrin.h>
+#define RING_CPU_RELAX() _mm_pause()
+#else
+#define RING_CPU_RELAX() ((void)0)
+#endif
+#include "ring.hpp"
+
+//! Number of busy-wait iterations before waiting thread yields the processor
+#define RING_SPIN_LIMIT 64
+
+/**
+ *    \fn           void backoff(unsigned& spins)
+ *    \brief        Waits shortly for the other side of the ring
+ *    \param[in,out] spins
+ *                    Number of waits performed so far
+ */
+static inline void backoff(unsigned& spins)
+{
+    if (spins++ < RING_SPIN_LIMIT) RING_CPU_RELAX();
+    else std::this_thread::yield();
+}
+
+RecordRing::RecordRing(size_t capacity)
+: m_writePos(0), m_closed(false), m_fullStalls(0), m_cachedReadPos(0),
+  m_readPos(0), m_emptyStalls(0), m_cachedWritePos(0), m_frontSize(0)
+{
+    m_capacity = 64;
+    while (m_capacity < capacity) m_capacity *= 2;
+    m_mask = m_capacity - 1;
+    m_buffer.reset(new char[m_capacity]);
+}
+
+/**
+ *    \fn           bool RecordRing::push(uint32_t tag, const char* data, size_t len)
+ *    \brief        Copies record into the ring, waiting for free space if needed
+ *    \param[in]    tag
+ *                    Tag of the record
+ *    \param[in]    data
+ *                    Content of the record
+ *    \param[in]    len
+ *                    Length of the content in bytes
+ *    \return       Boolean value determining if record fits into the ring at all
+ *    \note         Every record of ringRecordSize(len) <= capacity() fits, also when it follows
+ *                  space skipped at the end of the ring
+ *    \warning      May be called by the producer thread only
+ */
+bool RecordRing::push(uint32_t tag, const char* data, size_t len)
+{
+    size_t size = ringRecordSize(len);
+    if (size > m_capacity) return false;
+
+    // Record must not be split, so space left at the end of the ring is skipped first. It is
+    // published on its own, as together with the record it may exceed the capacity.
+    size_t writePos = m_writePos.load(std::memory_order_relaxed);
+    size_t offset = writePos & m_mask;
+    size_t contiguous = m_capacity - offset;
+    if (size > contiguous) {
+        waitForSpace(writePos, contiguous);
+        RecordHeader wrap = { RING_TAG_WRAP, 0 };
+        memcpy(m_buffer.get() + offset, &wrap, sizeof(wrap));
+        writePos += contiguous;
+        m_writePos.store(writePos, std::memory_order_release);
+        offset = 0;
+    }
+    waitForSpace(writePos, size);
+
+    RecordHeader header = { tag, static_cast<uint32_t>(len) };
+    memcpy(m_buffer.get() + offset, &header, sizeof(header));
+    if (len > 0) memcpy(m_buffer.get() + offset + sizeof(header), data, len);
+
+    // Publish the record
+    m_writePos.store(writePos + size, std::memory_order_release);
+    return true;
+}
+
+/**
+ *    \fn           void RecordRing::waitForSpace(size_t writePos, size_t size)
+ *    \brief        Waits until consumer frees space following the write position
+ *    \param[in]    writePos
+ *                    Current write position
+ *    \param[in]    size
+ *                    Number of needed bytes (at most the capacity)
+ */
+void RecordRing::waitForSpace(size_t writePos, size_t size)
+{
+    if (writePos + size - m_cachedReadPos <= m_capacity) return;
+    m_cachedReadPos = m_readPos.load(std::memory_order_acquire);
+    if (writePos + size - m_cachedReadPos <= m_capacity) return;
+
+    m_fullStalls.fetch_add(1, std::memory_order_relaxed);
+    unsigned spins = 0;
+    do {
+        backoff(spins);
+        m_cachedReadPos = m_readPos.load(std::memory_order_acquire);
+    } while (writePos + size - m_cachedReadPos > m_capacity);
+}
+
+/**
+ *    \fn           void RecordRing::close()
+ *    \brief        Marks that no more records will be pushed
+ *    \warning      May be called by the producer thread only
+ */
+void RecordRing::close()
+{
+    m_closed.store(true, std::memory_order_release);
+}
+
+/**
+ *    \fn           bool RecordRing::front(RingRecord& record)
+ *    \brief        Returns the oldest record, waiting for it if the ring is empty
+ *    \param[out]    record
+ *                    View of the record valid until pop() is called
+ *    \return       Boolean value determining if record was returned (false if ring is empty and closed)
+ *    \warning      May be called by the consumer thread only
+ */
+bool RecordRing::front(RingRecord& record)
+{
+    size_t readPos = m_readPos.load(std::memory_order_relaxed);
+    unsigned spins = 0;
+    bool stalled = false;
+
+    while (true) {
+        // Wait until producer publishes a record
+        if (readPos == m_cachedWritePos) {
+            m_cachedWritePos = m_writePos.load(std::memory_order_acquire);
+            if (readPos == m_cachedWritePos) {
+                if (m_closed.load(std::memory_order_acquire)) {
+                    // Records pushed before closing are visible now
+                    m_cachedWritePos = m_writePos.load(std::memory_order_acquire);
+                    if (readPos == m_cachedWritePos) return false;
+                    continue;
+                }
+                if (!stalled) {
+                    m_emptyStalls.fetch_add(1, std::memory_order_relaxed);
+                    stalled = true;
+                }
+                backoff(spins);
+                continue;
+            }
+        }
+
+        RecordHeader header;
+        size_t offset = readPos & m_mask;
+        memcpy(&header, m_buffer.get() + offset, sizeof(header));
+
+        // Skip space left at the end of the ring
+        if (header.tag == RING_TAG_WRAP) {
+            readPos += m_capacity - offset;
+            m_readPos.store(readPos, std::memory_order_release);
+            continue;
+        }
+
+        record.tag = header.tag;
+        record.data = m_buffer.get() + offset + sizeof(header);
+        record.len = header.len;
+        m_frontSize = ringRecordSize(header.len);
+        return true;
+    }
+}
+
+/**
+ *    \fn           void RecordRing::pop()
+ *    \brief        Releases space of the record returned by front()
+ *    \warning      May be called by the consumer thread only
+ */
+void RecordRing::pop()
+{
+    m_readPos.store(m_readPos.load(std::memory_order_relaxed) + m_frontSize, std::memory_order_release);
+    m_frontSize = 0;
+}
@@ -0,0 +1,148 @@
+/**
+ * \file ring.hpp
+ *
+ * \brief Header file of 'ring.cpp'.
+ *
+ * \details This file includes declaration of lock-free single-producer/single-consumer ring buffer carrying output records between threads.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef ring_hpp
+#define ring_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+
+using std::atomic;
+using std::unique_ptr;
+
+//! Default capacity of the record ring in bytes
+#define DEFAULT_RING_CAPACITY (4 * 1024 * 1024)
+//! Tag of the record filling the space left at the end of the ring
+#define RING_TAG_WRAP 0xFFFFFFFFu
+//! Tag of the empty record marking end of a batch of records
+#define RING_TAG_BATCH_END 0xFFFFFFFEu
+
+/**
+ *    \fn           size_t ringRecordSize(size_t len)
+ *    \brief        Returns space occupied in the ring by a record
+ *    \param[in]    len
+ *                    Length of the record content in bytes
+ *    \return       Size of header and content rounded up to a multiple of 8 bytes
+ */
+inline size_t ringRecordSize(size_t len)
+{
+    return (2*sizeof(uint32_t) + len + 7) & ~static_cast<size_t>(7);
+}
+
+/**
+ *    \struct       RingRecord
+ *    \brief        Structure for storing view of a record read from the ring
+ */
+struct RingRecord {
+    uint32_t tag;           /*!< Tag of the record (MMSI number of output records) */
+    const char* data;       /*!< Pointer to the content of the record inside the ring */
+    size_t len;             /*!< Length of the content in bytes */
+};
+
+/**
+ *    \class        RecordRing
+ *    \brief        Lock-free single-producer/single-consumer ring of variable length records
+ *    \details      Each record consists of a tag, a length and the content copied into the ring.
+ *                  Producer and consumer only synchronize through atomic read and write positions.
+ *                  Each side counts how many times it had to wait for the other one, which shows
+ *                  whether producing or consuming is the bottleneck.
+ */
+class RecordRing {
+public:
+    /**
+     *    \fn           RecordRing(size_t capacity)
+     *    \brief        Creates empty ring
+     *    \param[in]    capacity
+     *                    Capacity of the ring in bytes (rounded up to a power of 2)
+     */
+    explicit RecordRing(size_t capacity = DEFAULT_RING_CAPACITY);
+    RecordRing(const RecordRing&) = delete;
+    RecordRing& operator=(const RecordRing&) = delete;
+
+    /**
+     *    \fn           bool push(uint32_t tag, const char* data, size_t len)
+     *    \brief        Copies record into the ring, waiting for free space if needed
+     *    \param[in]    tag
+     *                    Tag of the record
+     *    \param[in]    data
+     *                    Content of the record
+     *    \param[in]    len
+     *                    Length of the content in bytes
+     *    \return       Boolean value determining if record fits into the ring at all
+     *    \note         Every record of ringRecordSize(len) <= capacity() fits, also when it follows
+     *                  space skipped at the end of the ring
+     *    \warning      May be called by the producer thread only
+     */
+    bool push(uint32_t tag, const char* data, size_t len);
+    /**
+     *    \fn           void close()
+     *    \brief        Marks that no more records will be pushed
+     *    \warning      May be called by the producer thread only
+     */
+    void close();
+
+    /**
+     *    \fn           bool front(RingRecord& record)
+     *    \brief        Returns the oldest record, waiting for it if the ring is empty
+     *    \param[out]    record
+     *                    View of the record valid until pop() is called
+     *    \return       Boolean value determining if record was returned (false if ring is empty and closed)
+     *    \warning      May be called by the consumer thread only
+     */
+    bool front(RingRecord& record);
+    /**
+     *    \fn           void pop()
+     *    \brief        Releases space of the record returned by front()
+     *    \warning      May be called by the consumer thread only
+     */
+    void pop();
+
+    uint64_t fullStalls() const { return m_fullStalls.load(std::memory_order_relaxed); }   /*!< Returns number of waits of the producer */
+    uint64_t emptyStalls() const { return m_emptyStalls.load(std::memory_order_relaxed); } /*!< Returns number of waits of the consumer */
+    size_t capacity() const { return m_capacity; }                                          /*!< Returns capacity of the ring in bytes */
+
+private:
+    /**
+     *    \struct       RecordHeader
+     *    \brief        Header preceding content of every record
+     */
+    struct RecordHeader {
+        uint32_t tag;       /*!< Tag of the record */
+        uint32_t len;       /*!< Length of the content in bytes */
+    };
+
+    /**
+     *    \fn           void waitForSpace(size_t writePos, size_t size)
+     *    \brief        Waits until consumer frees space following the write position
+     *    \param[in]    writePos
+     *                    Current write position
+     *    \param[in]    size
+     *                    Number of needed bytes (at most the capacity)
+     */
+    void waitForSpace(size_t writePos, size_t size);
+
+    unique_ptr<char[]> m_buffer;            /*!< Storage of the records */
+    size_t m_capacity;                      /*!< Capacity of the ring in bytes */
+    size_t m_mask;                          /*!< Mask converting positions to offsets */
+
+    alignas(64) atomic<size_t> m_writePos;  /*!< Number of bytes ever pushed (written by producer) */
+    atomic<bool> m_closed;                  /*!< Determines if producer has finished */
+    atomic<uint64_t> m_fullStalls;          /*!< Number of waits of the producer */
+    size_t m_cachedReadPos;                 /*!< Producer's copy of the read position */
+
+    alignas(64) atomic<size_t> m_readPos;   /*!< Number of bytes ever popped (written by consumer) */
+    atomic<uint64_t> m_emptyStalls;         /*!< Number of waits of the consumer */
+    size_t m_cachedWritePos;                /*!< Consumer's copy of the write position */
+    size_t m_frontSize;                     /*!< Size of the record returned by front() */
+};
+
+#endif /* ring_hpp */
@@ -0,0 +1,207 @@
+/**
+ * \file scan.cpp
+ *
+ * \brief Functions for structural scanning of input data.
+ *
+ * \details This file includes definitions of functions locating structural characters of raw AIS logs in large input blocks and validating checksums of raw sentences using vector instructions.
+ *
+ * \date    16/10/2026
+ */
+
+#include "scan.hpp"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SCAN_USE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ *    \fn           unsigned countTrailingZeros(uint32_t mask)
+ *    \brief        Returns index of the lowest set bit
+ *    \param[in]    mask
+ *                    Non-zero bit mask
+ *    \return       Index of the lowest set bit
+ */
+static inline unsigned countTrailingZeros(uint32_t mask)
+{
+#ifdef _MSC_VER
+    unsigned long idx;
+    _BitScanForward(&idx, mask);
+    return idx;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+/**
+ *    \fn           bool isStructuralCharacter(char c)
+ *    \brief        Checks if character is a structural character
+ *    \param[in]    c
+ *                    Checked character
+ *    \return       Boolean value determining if character is structural
+ */
+static inline bool isStructuralCharacter(char c)
+{
+    return c == '\t' || c == ',' || c == '*' || c == '\n';
+}
+
+/**
+ *    \fn           uint32_t* flattenMask(uint32_t mask, uint32_t offset, uint32_t* out)
+ *    \brief        Converts bit mask of found characters into their positions
+ *    \param[in]    mask
+ *                    Bit mask of found characters
+ *    \param[in]    offset
+ *                    Offset of the bit 0 relative to the block beginning
+ *    \param[out]    out
+ *                    Pointer to the first free entry of the positions array
+ *    \return       Pointer to the first free entry after appended positions
+ */
+static inline uint32_t* flattenMask(uint32_t mask, uint32_t offset, uint32_t* out)
+{
+    while (mask) {
+        *out++ = offset + countTrailingZeros(mask);
+        mask &= mask - 1; // clear the lowest set bit
+    }
+    return out;
+}
+
+/**
+ *    \fn           void buildStructuralIndex(const char* block, size_t len, StructuralIndex& index)
+ *    \brief        Finds all structural characters of input block
+ *    \param[in]    block
+ *                    Pointer to the beginning of the block
+ *    \param[in]    len
+ *                    Length of the block in bytes
+ *    \param[out]    index
+ *                    Structure for storing found positions in ascending order
+ *    \note         Uses AVX2 or SSE2 instructions when available, scalar code otherwise
+ *    \warning      len must not exceed STRUCTURAL_BLOCK_SIZE
+ */
+void buildStructuralIndex(const char* block, size_t len, StructuralIndex& index)
+{
+    // Every character of the block may be structural in the worst case
+    if (index.positions.size() < len) index.positions.resize(len);
+    uint32_t* out = index.positions.data();
+    size_t i = 0;
+
+#if defined(__AVX2__)
+    const __m256i tab = _mm256_set1_epi8('\t');
+    const __m256i comma = _mm256_set1_epi8(',');
+    const __m256i asterisk = _mm256_set1_epi8('*');
+    const __m256i newline = _mm256_set1_epi8('\n');
+    for (; i + 32 <= len; i += 32) {
+        __m256i chunk = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + i));
+        __m256i found = _mm256_or_si256(
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, tab), _mm256_cmpeq_epi8(chunk, comma)),
+            _mm256_or_si256(_mm256_cmpeq_epi8(chunk, asterisk), _mm256_cmpeq_epi8(chunk, newline)));
+        out = flattenMask(static_cast<uint32_t>(_mm256_movemask_epi8(found)), static_cast<uint32_t>(i), out);
+    }
+#elif defined(SCAN_USE_SSE2)
+    const __m128i tab = _mm_set1_epi8('\t');
+    const __m128i comma = _mm_set1_epi8(',');
+    const __m128i asterisk = _mm_set1_epi8('*');
+    const __m128i newline = _mm_set1_epi8('\n');
+    for (; i + 16 <= len; i += 16) {
+        __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + i));
+        __m128i found = _mm_or_si128(
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, tab), _mm_cmpeq_epi8(chunk, comma)),
+            _mm_or_si128(_mm_cmpeq_epi8(chunk, asterisk), _mm_cmpeq_epi8(chunk, newline)));
+        out = flattenMask(static_cast<uint32_t>(_mm_movemask_epi8(found)), static_cast<uint32_t>(i), out);
+    }
+#endif
+
+    // Scalar processing of the remaining characters
+    for (; i < len; i++) {
+        if (isStructuralCharacter(block[i])) *out++ = static_cast<uint32_t>(i);
+    }
+
+    index.count = out - index.positions.data();
+}
+
+/**
+ *    \fn           unsigned char xorReduce(const char* data, size_t len)
+ *    \brief        Computes XOR of all bytes of the buffer
+ *    \param[in]    data
+ *                    Pointer to the beginning of the buffer
+ *    \param[in]    len
+ *                    Length of the buffer in bytes
+ *    \return       XOR of all bytes
+ *    \note         Uses AVX2 or SSE2 instructions when available, scalar code otherwise
+ */
+unsigned char xorReduce(const char* data, size_t len)
+{
+    unsigned char checksum = 0;
+    size_t i = 0;
+
+#if defined(__AVX2__) || defined(SCAN_USE_SSE2)
+    if (len >= 16) {
+        __m128i acc = _mm_setzero_si128();
+#if defined(__AVX2__)
+        if (len >= 32) {
+            __m256i acc256 = _mm256_setzero_si256();
+            for (; i + 32 <= len; i += 32) {
+                acc256 = _mm256_xor_si256(acc256, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(data + i)));
+            }
+            acc = _mm_xor_si128(_mm256_castsi256_si128(acc256), _mm256_extracti128_si256(acc256, 1));
+        }
+#endif
+        for (; i + 16 <= len; i += 16) {
+            acc = _mm_xor_si128(acc, _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i)));
+        }
+        
+        // Fold 16 lanes into a single byte
+        acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 8));
+        acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 4));
+        acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 2));
+        acc = _mm_xor_si128(acc, _mm_srli_si128(acc, 1));
+        checksum = static_cast<unsigned char>(_mm_cvtsi128_si32(acc));
+    }
+#endif
+
+    // Scalar processing of the remaining bytes
+    for (; i < len; i++) checksum ^= static_cast<unsigned char>(data[i]);
+
+    return checksum;
+}
+
+/**
+ *    \fn           int hexDigitValue(char c)
+ *    \brief        Converts hexadecimal digit to its value
+ *    \param[in]    c
+ *                    Hexadecimal digit
+ *    \return       Value of the digit or -1 if character is not a hexadecimal digit
+ */
+static inline int hexDigitValue(char c)
+{
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+/**
+ *    \fn           bool validateNMEAChecksum(string_view sentence)
+ *    \brief        Checks if checksum of raw NMEA sentence matches its content
+ *    \param[in]    sentence
+ *                    Raw sentence starting with '!' or '$' and ending with '*hh' checksum
+ *    \return       Boolean value determining if checksum is valid
+ *    \note         Sentences without checksum are reported as invalid
+ */
+bool validateNMEAChecksum(string_view sentence)
+{
+    // Shortest sentence consists of start character and '*hh' checksum
+    size_t len = sentence.size();
+    if (len < 4 || (sentence[0] != '!' && sentence[0] != '$') || sentence[len-3] != '*') return false;
+    
+    int high = hexDigitValue(sentence[len-2]);
+    int low = hexDigitValue(sentence[len-1]);
+    if (high < 0 || low < 0) return false;
+    
+    // Checksum covers characters between start character and '*'
+    return xorReduce(sentence.data() + 1, len - 4) == ((high << 4) | low);
+}
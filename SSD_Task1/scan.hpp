@@ -0,0 +1,72 @@
+/**
+ * \file scan.hpp
+ *
+ * \brief Header file of 'scan.cpp'.
+ *
+ * \details This file includes declarations of functions locating structural characters of raw AIS logs in large input blocks and validating checksums of raw sentences.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef scan_hpp
+#define scan_hpp
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <string_view>
+
+using std::vector;
+using std::string_view;
+
+//! Size of the input block indexed at once
+#define STRUCTURAL_BLOCK_SIZE (1 << 20)
+
+/**
+ *    \struct       StructuralIndex
+ *    \brief        Structure for storing positions of structural characters found in input block
+ *    \details      Structural characters are tabs separating line components, commas separating
+ *                  elements of AIS message, asterisks preceding checksums and newlines.
+ */
+struct StructuralIndex {
+    vector<uint32_t> positions; /*!< Offsets of structural characters relative to the block beginning */
+    size_t count = 0;           /*!< Number of valid entries in positions */
+};
+
+/**
+ *    \fn           void buildStructuralIndex(const char* block, size_t len, StructuralIndex& index)
+ *    \brief        Finds all structural characters of input block
+ *    \param[in]    block
+ *                    Pointer to the beginning of the block
+ *    \param[in]    len
+ *                    Length of the block in bytes
+ *    \param[out]    index
+ *                    Structure for storing found positions in ascending order
+ *    \note         Uses AVX2 or SSE2 instructions when available, scalar code otherwise
+ *    \warning      len must not exceed STRUCTURAL_BLOCK_SIZE
+ */
+void buildStructuralIndex(const char* block, size_t len, StructuralIndex& index);
+
+/**
+ *    \fn           unsigned char xorReduce(const char* data, size_t len)
+ *    \brief        Computes XOR of all bytes of the buffer
+ *    \param[in]    data
+ *                    Pointer to the beginning of the buffer
+ *    \param[in]    len
+ *                    Length of the buffer in bytes
+ *    \return       XOR of all bytes
+ *    \note         Uses AVX2 or SSE2 instructions when available, scalar code otherwise
+ */
+unsigned char xorReduce(const char* data, size_t len);
+
+/**
+ *    \fn           bool validateNMEAChecksum(string_view sentence)
+ *    \brief        Checks if checksum of raw NMEA sentence matches its content
+ *    \param[in]    sentence
+ *                    Raw sentence starting with '!' or '$' and ending with '*hh' checksum
+ *    \return       Boolean value determining if checksum is valid
+ *    \note         Sentences without checksum are reported as invalid
+ */
+bool validateNMEAChecksum(string_view sentence);
+
+#endif /* scan_hpp */
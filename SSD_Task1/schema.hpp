@@ -0,0 +1,165 @@
+/**
+ * \file schema.hpp
+ *
+ * \brief Compile-time schema of AIS message fields.
+ *
+ * \details This file includes templates describing position, length and signedness of AIS message fields and schemas of supported message types. Extractors generated from the schema are fully inlined, so that offsets of the fields are folded into constant shifts and masks.
+ *
+ * \date    16/10/2026
+ */
+/*
+ * AIVDM message layouts: <a href="http://catb.org/gpsd/AIVDM.html">More info</a>
+ */
+
+#ifndef schema_hpp
+#define schema_hpp
+
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#ifdef _MSC_VER
+#include <stdlib.h>
+#endif
+#include "main.hpp"
+
+/**
+ *    \fn           uint64_t loadBigEndian64(const byte* msg)
+ *    \brief        Loads 8 subsequent bytes as big-endian word
+ *    \param[in]    msg
+ *                    Pointer to the first byte
+ *    \return       Loaded word with msg[0] as the most significant byte
+ */
+inline uint64_t loadBigEndian64(const byte* msg)
+{
+    uint64_t word;
+    memcpy(&word, msg, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+    return word;
+#elif defined(_MSC_VER)
+    return _byteswap_uint64(word);
+#else
+    return __builtin_bswap64(word);
+#endif
+}
+
+/**
+ *    \struct       Field
+ *    \brief        Description of a single numeric field of AIS message
+ *    \tparam       Offset
+ *                    Index of the starting bit
+ *    \tparam       Len
+ *                    Length of bit field (1-32)
+ *    \tparam       Signed
+ *                    Determines if field is stored in two's complement
+ */
+template <unsigned Offset, unsigned Len, bool Signed = false>
+struct Field {
+    static_assert(Len >= 1 && Len <= 32, "Field must be 1-32 bits long");
+
+    typedef typename std::conditional<Signed, int, unsigned>::type value_type; /*!< Type of raw value */
+    static constexpr unsigned offset = Offset;  /*!< Index of the starting bit */
+    static constexpr unsigned length = Len;     /*!< Length of bit field */
+    static constexpr bool isSigned = Signed;    /*!< Two's complement flag */
+
+    /**
+     *    \fn           static value_type extract(const byte* msg)
+     *    \brief        Extracts raw value of the field from AIS message in binary format
+     *    \param[in]    msg
+     *                    AIS message in binary format
+     *    \return       Raw value of the field
+     */
+    static value_type extract(const byte* msg)
+    {
+        return fromWord(loadBigEndian64(msg + Offset/8), Offset/8*8);
+    }
+
+    /**
+     *    \fn           static value_type fromWord(uint64_t word, unsigned wordOffset)
+     *    \brief        Extracts raw value of the field from already loaded big-endian word
+     *    \param[in]    word
+     *                    Word containing the field
+     *    \param[in]    wordOffset
+     *                    Index of the bit stored as the most significant bit of the word
+     *    \return       Raw value of the field
+     */
+    static value_type fromWord(uint64_t word, unsigned wordOffset)
+    {
+        word <<= (Offset - wordOffset);
+        if (Signed) return static_cast<value_type>(static_cast<int64_t>(word) >> (64 - Len));
+        else return static_cast<value_type>(word >> (64 - Len));
+    }
+};
+
+/**
+ *    \struct       FieldGroup
+ *    \brief        Group of fields extracted with a single load
+ *    \details      All fields of the group must lie within 64 bits starting at the byte
+ *                  containing the first bit of the first field.
+ */
+template <class First, class... Rest>
+struct FieldGroup {
+    static constexpr unsigned wordOffset = First::offset/8*8;   /*!< Index of the first loaded bit */
+
+    /**
+     *    \fn           static constexpr bool fitsInWord()
+     *    \brief        Checks if all fields of the group lie within the loaded word
+     *    \return       Boolean value determining if group can be extracted with a single load
+     */
+    static constexpr bool fitsInWord()
+    {
+        bool fits = First::offset + First::length <= wordOffset + 64;
+        bool rest[] = { true, (Rest::offset >= wordOffset && Rest::offset + Rest::length <= wordOffset + 64)... };
+        for (bool r : rest) fits = fits && r;
+        return fits;
+    }
+    static_assert(fitsInWord(), "Fields of the group do not fit into a single 64-bit word");
+
+    /**
+     *    \fn           static void extract(const byte* msg, typename First::value_type& first, typename Rest::value_type&... rest)
+     *    \brief        Extracts raw values of all fields of the group
+     *    \param[in]    msg
+     *                    AIS message in binary format
+     *    \param[out]    first
+     *                    Raw value of the first field
+     *    \param[out]    rest
+     *                    Raw values of the remaining fields
+     */
+    static void extract(const byte* msg, typename First::value_type& first, typename Rest::value_type&... rest)
+    {
+        uint64_t word = loadBigEndian64(msg + wordOffset/8);
+        first = First::fromWord(word, wordOffset);
+        int expand[] = { 0, (rest = Rest::fromWord(word, wordOffset), 0)... };
+        (void)expand;
+    }
+};
+
+/**
+ *    \struct       CommonHeaderSchema
+ *    \brief        Fields shared by all AIS message types
+ */
+struct CommonHeaderSchema {
+    typedef Field<0, 6> MessageType;            /*!< Message Type */
+    typedef Field<6, 2> RepeatIndicator;        /*!< Repeat Indicator */
+    typedef Field<8, 30> MMSI;                  /*!< MMSI */
+};
+
+/**
+ *    \struct       PositionReportSchema
+ *    \brief        Fields of Position Report Class A (types 1, 2 and 3)
+ */
+struct PositionReportSchema : CommonHeaderSchema {
+    typedef Field<38, 4> NavigationStatus;                      /*!< Navigation Status */
+    typedef Field<42, 8, true> RateOfTurn;                      /*!< Rate Of Turn (raw AIS value) */
+    typedef Field<50, 10> SpeedOverGround;                      /*!< Speed Over Ground [0.1 knot] */
+    typedef Field<60, 1> PositionAccuracy;                      /*!< Position Accuracy */
+    typedef Field<61, 28, true> Longitude;                      /*!< Longitude [1/10000 min] */
+    typedef Field<89, 27, true> Latitude;                       /*!< Latitude [1/10000 min] */
+    typedef Field<116, 12> CourseOverGround;                    /*!< Course Over Ground [0.1 deg] */
+    typedef Field<128, 9> TrueHeading;                          /*!< True Heading [deg] */
+    typedef Field<137, 6> TimeStamp;                            /*!< Time Stamp [s] */
+    typedef Field<143, 2> ManeuverIndicator;                    /*!< Maneuver Indicator */
+    typedef Field<148, 1> RAIMFlag;                             /*!< RAIM Flag */
+    typedef Field<149, 19> RadioStatus;                         /*!< Radio Status */
+};
+
+#endif /* schema_hpp */
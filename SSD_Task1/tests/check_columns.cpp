@@ -0,0 +1,99 @@
+/**
+ * \file check_columns.cpp
+ *
+ * \brief Check of columnar decoding of position reports.
+ *
+ * \details This file contains program comparing every column filled by decodeBatch() with decodePositionReport(), for batch sizes covering both the 8-message vector steps and the scalar tail.
+ *
+ * \date    16/10/2026
+ */
+
+#include <iostream>
+#include <random>
+#include <vector>
+#include <algorithm>
+#include "../columns.hpp"
+#include "../report.hpp"
+
+using std::vector;
+using std::cout;
+using std::endl;
+
+//! Number of random messages
+#define RANDOM_MESSAGE_NUM 1003
+
+/**
+ *    \fn           unsigned checkColumns(const AISPayloadView* msgs, size_t count, PositionColumns& columns)
+ *    \brief        Decodes batch and compares every column with decodePositionReport()
+ *    \param[in]    msgs
+ *                    Views of packed position reports
+ *    \param[in]    count
+ *                    Number of messages
+ *    \param[in,out] columns
+ *                    Columns reused between batches
+ *    \return       Number of mismatching values
+ */
+static unsigned checkColumns(const AISPayloadView* msgs, size_t count, PositionColumns& columns)
+{
+    decodeBatch(msgs, count, columns);
+    unsigned errorCnt = 0;
+    if (columns.size != count || columns.mmsi.size() != count || columns.hdg.size() != count) {
+        cout << "batch of " << count << ": wrong size " << columns.size << endl;
+        return 1;
+    }
+    for (size_t row = 0; row < count; row++) {
+        PositionReport report;
+        decodePositionReport(msgs[row].data(), report);
+        bool match = columns.messageType[row] == report.messageType && columns.mmsi[row] == report.MMSI &&
+                     columns.status[row] == report.status && columns.sog[row] == report.speedOverGround &&
+                     columns.lon[row] == report.longitude && columns.lat[row] == report.latitude &&
+                     columns.cog[row] == report.courseOverGround && columns.hdg[row] == report.trueHeading;
+        if (!match) {
+            cout << "batch of " << count << ", row " << row << ": columns differ from decodePositionReport" << endl;
+            errorCnt++;
+        }
+    }
+    return errorCnt;
+}
+
+/**
+ *    \fn           int main()
+ *    \brief        Runs the check
+ *    \return       0 if all columns match, 1 otherwise
+ */
+int main()
+{
+    // Messages are stored in separate buffers visited in random order, so that distances
+    // between subsequent messages vary and are also negative
+    std::mt19937 generator(2019);
+    vector<vector<byte>> buffers(RANDOM_MESSAGE_NUM, vector<byte>(packedPayloadSize(28), 0));
+    vector<AISPayloadView> msgs;
+    for (vector<byte>& buffer : buffers) {
+        for (size_t b = 0; b < AIS_SINGLE_SLOT_BYTES; b++) buffer[b] = static_cast<byte>(generator());
+        msgs.push_back(AISPayloadView(buffer.data(), 168));
+    }
+    std::shuffle(msgs.begin(), msgs.end(), generator);
+
+    // Known position report first
+    ScratchArena arena;
+    if (!makePayloadView("13u?etPv2;0n:dDPwUM1U1Cb069D", arena, msgs[0])) {
+        cout << "makePayloadView: valid payload rejected" << endl;
+        return 1;
+    }
+
+    // Batch sizes below, at and above the vector step, and whole batch with a tail of 3 messages
+    unsigned errorCnt = 0;
+    PositionColumns columns;
+    size_t counts[] = { 0, 1, 7, 8, 9, 15, 16, 17, RANDOM_MESSAGE_NUM };
+    for (size_t count : counts) errorCnt += checkColumns(msgs.data(), count, columns);
+    for (size_t start = 1; start < 8; start++) errorCnt += checkColumns(msgs.data() + start, RANDOM_MESSAGE_NUM - start, columns);
+
+    PositionColumns known = decodeBatch(msgs.data(), 1);
+    if (known.mmsi[0] != 265547250 || known.sog[0] != 139 || known.cog[0] != 404 || known.hdg[0] != 41) {
+        cout << "known message decoded incorrectly" << endl;
+        errorCnt++;
+    }
+
+    cout << "check_columns: " << errorCnt << " mismatches" << endl;
+    return errorCnt == 0 ? 0 : 1;
+}
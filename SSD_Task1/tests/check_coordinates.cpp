@@ -0,0 +1,117 @@
+/**
+ * \file check_coordinates.cpp
+ *
+ * \brief Check of integer formatting of coordinates.
+ *
+ * \details This file contains program comparing writeLongitude() and writeLatitude() with the floating point formatting they replaced, on special values, range boundaries, rounding edges and a strided sweep over all raw values.
+ *
+ * \date    16/10/2026
+ */
+
+#include <iostream>
+#include <string>
+#include "../decoding.hpp"
+
+using std::string;
+using std::to_string;
+using std::cout;
+using std::endl;
+
+//! Raw longitude meaning 'not available' (181 degrees)
+#define LONGITUDE_NOT_AVAILABLE 0x6791AC0
+//! Raw latitude meaning 'not available' (91 degrees)
+#define LATITUDE_NOT_AVAILABLE 0x3412140
+//! Stride of the sweep over all raw values
+#define SWEEP_STRIDE 97
+
+/**
+ *    \fn           string referenceCoordinate(int value, int notAvailable, double limit)
+ *    \brief        Formats coordinate the way getLongitude() and getLatitude() did with floating point arithmetic
+ *    \param[in]    value
+ *                    Raw value in 1/10000 min
+ *    \param[in]    notAvailable
+ *                    Raw value meaning 'not available'
+ *    \param[in]    limit
+ *                    Largest valid absolute value in degrees
+ *    \return       Expected text
+ */
+static string referenceCoordinate(int value, int notAvailable, double limit)
+{
+    if (value == notAvailable) return "not available";
+    double degrees = static_cast<double>(value)/600000.0;
+    if (degrees < -limit || degrees > limit) return "error";
+    return to_string(degrees) + " [deg]";
+}
+
+/**
+ *    \fn           unsigned checkValue(int value, bool isLongitude)
+ *    \brief        Compares formatting of a single raw value with the reference
+ *    \param[in]    value
+ *                    Raw value in 1/10000 min
+ *    \param[in]    isLongitude
+ *                    Determines if value is longitude (latitude otherwise)
+ *    \return       Number of mismatches (0 or 1)
+ */
+static unsigned checkValue(int value, bool isLongitude)
+{
+    char text[COORDINATE_TEXT_SIZE];
+    string result = isLongitude ? string(text, writeLongitude(value, text)) : string(text, writeLatitude(value, text));
+    string expected = isLongitude ? referenceCoordinate(value, LONGITUDE_NOT_AVAILABLE, 180.0)
+                                  : referenceCoordinate(value, LATITUDE_NOT_AVAILABLE, 90.0);
+    if (result == expected) return 0;
+    cout << (isLongitude ? "LON " : "LAT ") << value << ": '" << result << "', expected '" << expected << "'" << endl;
+    return 1;
+}
+
+/**
+ *    \fn           unsigned checkCoordinate(unsigned bits, int limit, int notAvailable, bool isLongitude)
+ *    \brief        Compares formatting of selected raw values of one coordinate with the reference
+ *    \param[in]    bits
+ *                    Length of the field in bits
+ *    \param[in]    limit
+ *                    Largest valid absolute raw value
+ *    \param[in]    notAvailable
+ *                    Raw value meaning 'not available'
+ *    \param[in]    isLongitude
+ *                    Determines if values are longitudes (latitudes otherwise)
+ *    \return       Number of mismatches
+ */
+static unsigned checkCoordinate(unsigned bits, int limit, int notAvailable, bool isLongitude)
+{
+    int minValue = -(1 << (bits - 1));
+    int maxValue = (1 << (bits - 1)) - 1;
+    unsigned errorCnt = 0;
+
+    // Range boundaries, special values and both ends of the field
+    int edges[] = { 0, limit, -limit, notAvailable, -notAvailable, minValue, maxValue };
+    for (int edge : edges) {
+        for (int value = edge - 64; value <= edge + 64; value++) {
+            if (value >= minValue && value <= maxValue) errorCnt += checkValue(value, isLongitude);
+        }
+    }
+
+    // Rounding edges of (5|v|+1)/3: every residue modulo 3 around whole degrees and micro-degrees
+    for (int degrees = -static_cast<int>(limit/600000); degrees <= limit/600000; degrees++) {
+        for (int offset = -6; offset <= 6; offset++) errorCnt += checkValue(degrees*600000 + offset, isLongitude);
+    }
+    for (int value = -3000; value <= 3000; value++) errorCnt += checkValue(value, isLongitude);
+
+    // Strided sweep over all raw values
+    for (long long value = minValue; value <= maxValue; value += SWEEP_STRIDE) {
+        errorCnt += checkValue(static_cast<int>(value), isLongitude);
+    }
+    return errorCnt;
+}
+
+/**
+ *    \fn           int main()
+ *    \brief        Runs the check
+ *    \return       0 if formatting matches the reference, 1 otherwise
+ */
+int main()
+{
+    unsigned errorCnt = checkCoordinate(28, 108000000, LONGITUDE_NOT_AVAILABLE, true)
+                      + checkCoordinate(27, 54000000, LATITUDE_NOT_AVAILABLE, false);
+    cout << "check_coordinates: " << errorCnt << " mismatches" << endl;
+    return errorCnt == 0 ? 0 : 1;
+}
@@ -0,0 +1,213 @@
+/**
+ * \file check_reassembly.cpp
+ *
+ * \brief Check of joining multi-sentence messages split between batches.
+ *
+ * \details This file contains program feeding interleaved sentences of multi-sentence messages to the reassembly table in batches restored from their preceding lines, as decoder threads do, and comparing joined messages and dropped counts with a single pass over all lines, for batch boundaries falling inside messages.
+ *
+ * \date    16/10/2026
+ */
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include "../reassembly.hpp"
+
+using std::string;
+using std::vector;
+using std::cout;
+using std::endl;
+
+//! Number of generated lines
+#define GENERATED_LINE_NUM 30000
+//! Maximal number of messages sent at once
+#define MAX_OPEN_MESSAGES 6
+
+/**
+ *    \struct       Sentence
+ *    \brief        Elements of a generated sentence (line without sentence has empty count)
+ */
+struct Sentence {
+    string msgCnt;      /*!< Message counter */
+    string msgNum;      /*!< Message number */
+    string seqID;       /*!< Sequence ID */
+    string channel;     /*!< Channel */
+    string payload;     /*!< Payload */
+};
+
+/**
+ *    \struct       OpenMessage
+ *    \brief        Message whose sentences are being generated
+ */
+struct OpenMessage {
+    unsigned sentenceCnt;   /*!< Number of sentences */
+    unsigned nextSentence;  /*!< Number of the next sentence */
+    char seqID;             /*!< Sequence ID */
+    char channel;           /*!< Channel */
+    char type;              /*!< Type character of the first payload */
+    bool slow;              /*!< Determines if sentences are sent just within the timeout */
+    size_t dueLine;         /*!< Number of the line of the next sentence of a slow message */
+};
+
+/**
+ *    \struct       Joined
+ *    \brief        Message completed by a line
+ */
+struct Joined {
+    size_t lineNum;     /*!< Number of the completing line */
+    string payload;     /*!< Joined payload */
+
+    bool operator==(const Joined& other) const { return lineNum == other.lineNum && payload == other.payload; }
+};
+
+/**
+ *    \fn           vector<Sentence> generateSentences(std::mt19937& generator)
+ *    \brief        Generates interleaved sentences of position reports and other messages
+ *    \param[in]    generator
+ *                    Source of random numbers
+ *    \return       Generated lines
+ *    \note         Sentences are sometimes lost, repeated or delayed beyond the timeout, and
+ *                  sequence IDs are reused by messages still being sent. Some messages of up to
+ *                  9 sentences span several times the timeout.
+ */
+static vector<Sentence> generateSentences(std::mt19937& generator)
+{
+    const string alphabet = "0123456789:;<=>?@ABCDEFGHIJKLMNOPQRSTUVW`abcdefghijklmnopqrstuvw";
+    vector<Sentence> lines;
+    vector<OpenMessage> open;
+    while (lines.size() < GENERATED_LINE_NUM) {
+        unsigned event = generator() % 100;
+        if (event < 30) {
+
+            // Line without a multi-sentence message, now and then a long quiet stretch
+            size_t quiet = (generator() % 50 == 0) ? REASSEMBLY_TIMEOUT_LINES + generator() % 40 : 1;
+            for (size_t l = 0; l < quiet; l++) lines.push_back(Sentence());
+            continue;
+        }
+        if (event < 55 || open.empty()) {
+            if (open.size() < MAX_OPEN_MESSAGES) {
+                const char types[] = { '1', '1', '3', '5', '8' };
+                bool slow = generator() % 10 == 0;
+                open.push_back({ (slow ? 5 : 2) + static_cast<unsigned>(generator() % 3), 1, static_cast<char>('0' + generator() % 10),
+                                 (generator() % 2) ? 'A' : 'B', types[generator() % 5], slow, lines.size() });
+            }
+            continue;
+        }
+
+        // Next sentence of a random message (slow one when it is due), occasionally lost or out of order
+        size_t idx = generator() % open.size();
+        for (size_t m = 0; m < open.size(); m++) {
+            if (open[m].slow && open[m].dueLine <= lines.size()) idx = m;
+        }
+        if (open[idx].slow && open[idx].dueLine > lines.size()) continue;
+        open[idx].dueLine = lines.size() + REASSEMBLY_TIMEOUT_LINES - generator() % 4;
+        OpenMessage& msg = open[idx];
+        unsigned sentenceNum = msg.nextSentence;
+        unsigned anomaly = generator() % 100;
+        if (anomaly == 0) sentenceNum++;
+        else if (anomaly == 1 && sentenceNum > 1) sentenceNum--;
+        if (anomaly == 2) msg.nextSentence++;
+        else if (sentenceNum <= msg.sentenceCnt) {
+            Sentence sentence;
+            sentence.msgCnt = string(1, static_cast<char>('0' + msg.sentenceCnt));
+            sentence.msgNum = string(1, static_cast<char>('0' + sentenceNum));
+            sentence.seqID = string(1, msg.seqID);
+            sentence.channel = string(1, msg.channel);
+            size_t len = 1 + generator() % 60;
+            for (size_t c = 0; c < len; c++) sentence.payload += alphabet[generator() % alphabet.size()];
+            if (sentenceNum == 1) sentence.payload[0] = msg.type;
+            lines.push_back(sentence);
+            msg.nextSentence++;
+        }
+        if (msg.nextSentence > msg.sentenceCnt) open.erase(open.begin() + idx);
+    }
+    return lines;
+}
+
+/**
+ *    \fn           void joinRange(const vector<AISMessageView>& views, const vector<Sentence>& lines, size_t begin, size_t end, FragmentReassembler& reassembler, vector<Joined>& joined)
+ *    \brief        Joins messages completed by a range of lines after restoring the table from the preceding lines
+ *    \param[in]    views
+ *                    Elements of the sentences
+ *    \param[in]    lines
+ *                    Generated lines
+ *    \param[in]    begin
+ *                    Number of the first line of the range
+ *    \param[in]    end
+ *                    Number of the line following the range
+ *    \param[in,out] reassembler
+ *                    Table joining sentences, shared by all ranges
+ *    \param[in,out] joined
+ *                    Messages completed by lines of the range
+ */
+static void joinRange(const vector<AISMessageView>& views, const vector<Sentence>& lines, size_t begin, size_t end,
+                      FragmentReassembler& reassembler, vector<Joined>& joined)
+{
+    string_view payload;
+    reassembler.reset(begin);
+    for (size_t l = (begin > REASSEMBLY_WINDOW_LINES) ? begin - REASSEMBLY_WINDOW_LINES : 0; l < begin; l++) {
+        if (!lines[l].msgCnt.empty()) reassembler.add(views[l], l, payload);
+    }
+    for (size_t l = begin; l < end; l++) {
+        if (!lines[l].msgCnt.empty() && reassembler.add(views[l], l, payload) == FRAGMENT_COMPLETE) joined.push_back({ l, string(payload) });
+    }
+    reassembler.finish(end, end == lines.size());
+}
+
+/**
+ *    \fn           int main()
+ *    \brief        Runs the check
+ *    \return       0 if every split of the lines joins the same messages as a single pass, 1 otherwise
+ */
+int main()
+{
+    std::mt19937 generator(2019);
+    vector<Sentence> lines = generateSentences(generator);
+    vector<AISMessageView> views(lines.size());
+    for (size_t l = 0; l < lines.size(); l++) {
+        views[l].msgCnt = lines[l].msgCnt;
+        views[l].msgNum = lines[l].msgNum;
+        views[l].seqID = lines[l].seqID;
+        views[l].channel = lines[l].channel;
+        views[l].payload = lines[l].payload;
+    }
+
+    // Types selected by default
+    const uint32_t types = (1u << 1) | (1u << 3);
+    FragmentReassembler whole(types);
+    vector<Joined> expected;
+    joinRange(views, lines, 0, lines.size(), whole, expected);
+    unsigned errorCnt = 0;
+    if (expected.empty() || whole.droppedCnt() == 0) {
+        cout << "generated lines neither complete nor drop messages" << endl;
+        errorCnt++;
+    }
+    for (const Joined& message : expected) {
+        if (message.payload[0] != '1' && message.payload[0] != '3') {
+            cout << "line " << message.lineNum << ": message of type not decoded joined" << endl;
+            errorCnt++;
+        }
+    }
+
+    // Batches shorter than a message, as long as the timeout and the restored window, and of random lengths (0)
+    size_t batchLengths[] = { 1, 2, 7, REASSEMBLY_TIMEOUT_LINES, REASSEMBLY_TIMEOUT_LINES + 1, REASSEMBLY_WINDOW_LINES, 1024, 0 };
+    for (size_t batchLength : batchLengths) {
+        FragmentReassembler split(types);
+        vector<Joined> joined;
+        size_t end;
+        for (size_t begin = 0; begin < lines.size(); begin = end) {
+            end = std::min(lines.size(), begin + (batchLength > 0 ? batchLength : 1 + generator() % 2000));
+            joinRange(views, lines, begin, end, split, joined);
+        }
+        if (joined != expected || split.droppedCnt() != whole.droppedCnt()) {
+            cout << "batches of " << batchLength << " lines: " << joined.size() << " joined and " << split.droppedCnt()
+                 << " dropped, expected " << expected.size() << " and " << whole.droppedCnt() << endl;
+            errorCnt++;
+        }
+    }
+
+    cout << "check_reassembly: " << errorCnt << " mismatches" << endl;
+    return errorCnt == 0 ? 0 : 1;
+}
@@ -0,0 +1,93 @@
+/**
+ * \file check_ring.cpp
+ *
+ * \brief Check of the record ring passing output records between threads.
+ *
+ * \details This file contains program pushing records of random lengths, up to the capacity of the ring, from one thread and checking their order and content in another one, so that records following space skipped at the end of the ring are covered.
+ *
+ * \date    16/10/2026
+ */
+
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+#include "../ring.hpp"
+
+using std::vector;
+using std::thread;
+using std::cout;
+using std::endl;
+
+//! Capacity of the checked ring in bytes
+#define CHECKED_RING_CAPACITY 256
+//! Number of pushed records
+#define PUSHED_RECORD_NUM 200000
+
+/**
+ *    \fn           char contentByte(uint32_t tag, size_t idx)
+ *    \brief        Returns expected byte of the record content
+ *    \param[in]    tag
+ *                    Tag of the record
+ *    \param[in]    idx
+ *                    Index of the byte
+ *    \return       Value of the byte
+ */
+static char contentByte(uint32_t tag, size_t idx)
+{
+    return static_cast<char>(tag * 31 + idx);
+}
+
+/**
+ *    \fn           int main()
+ *    \brief        Runs the check
+ *    \return       0 if all records were received intact and in order, 1 otherwise
+ */
+int main()
+{
+    RecordRing ring(CHECKED_RING_CAPACITY);
+    unsigned errorCnt = 0;
+
+    // Record larger than the ring is rejected, the largest one fitting is accepted
+    vector<char> data(CHECKED_RING_CAPACITY);
+    size_t maxLen = CHECKED_RING_CAPACITY - ringRecordSize(0);
+    if (ring.push(0, data.data(), maxLen + 1)) {
+        cout << "push: record larger than the ring accepted" << endl;
+        errorCnt++;
+    }
+
+    // Lengths are drawn in advance, so that the consumer can check them
+    std::mt19937 generator(2019);
+    vector<size_t> lengths(PUSHED_RECORD_NUM);
+    for (size_t& len : lengths) len = (generator() % 4 == 0) ? maxLen - generator() % 8 : generator() % (maxLen + 1);
+
+    thread producer([&ring, &lengths]() {
+        vector<char> content(CHECKED_RING_CAPACITY);
+        for (uint32_t tag = 0; tag < lengths.size(); tag++) {
+            for (size_t b = 0; b < lengths[tag]; b++) content[b] = contentByte(tag, b);
+            ring.push(tag, content.data(), lengths[tag]);
+        }
+        ring.close();
+    });
+
+    RingRecord record;
+    uint32_t expected = 0;
+    while (ring.front(record)) {
+        bool intact = record.tag == expected && expected < lengths.size() && record.len == lengths[expected];
+        for (size_t b = 0; intact && b < record.len; b++) intact = record.data[b] == contentByte(expected, b);
+        if (!intact) {
+            cout << "record " << expected << ": tag " << record.tag << ", length " << record.len << " differs" << endl;
+            errorCnt++;
+        }
+        expected = record.tag + 1;
+        ring.pop();
+    }
+    producer.join();
+    if (expected != PUSHED_RECORD_NUM) {
+        cout << "received " << expected << " records of " << PUSHED_RECORD_NUM << endl;
+        errorCnt++;
+    }
+
+    cout << "check_ring: " << errorCnt << " mismatches" << endl;
+    return errorCnt == 0 ? 0 : 1;
+}
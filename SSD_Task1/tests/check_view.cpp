@@ -0,0 +1,161 @@
+/**
+ * \file check_view.cpp
+ *
+ * \brief Check of lazy field accessors of AISPayloadView.
+ *
+ * \details This file contains program comparing every accessor of AISPayloadView with a bit by bit reference decoder of armored payload characters, which uses bit positions of the AIVDM specification instead of the schema, on known, truncated and random messages.
+ *
+ * \date    16/10/2026
+ */
+
+#include <iostream>
+#include <random>
+#include <string>
+#include "../view.hpp"
+
+using std::string;
+using std::cout;
+using std::endl;
+
+//! Number of random messages
+#define RANDOM_MESSAGE_NUM 100000
+//! Number of payload characters of a position report
+#define POSITION_REPORT_CHARS 28
+
+/**
+ *    \fn           long long referenceField(const string& payload, unsigned offset, unsigned length, bool isSigned)
+ *    \brief        Decodes field bit by bit from armored payload characters
+ *    \param[in]    payload
+ *                    Payload of AIS message
+ *    \param[in]    offset
+ *                    Index of the starting bit (AIVDM specification)
+ *    \param[in]    length
+ *                    Length of the field in bits
+ *    \param[in]    isSigned
+ *                    Determines if field is stored in two's complement
+ *    \return       Value of the field
+ */
+static long long referenceField(const string& payload, unsigned offset, unsigned length, bool isSigned)
+{
+    long long value = 0;
+    for (unsigned bit = offset; bit < offset + length; bit++) {
+        unsigned sixbit = static_cast<unsigned>(payload[bit / 6]) - 48;
+        if (sixbit > 40) sixbit -= 8;
+        value = (value << 1) | ((sixbit >> (5 - bit % 6)) & 1);
+    }
+    if (isSigned && ((value >> (length - 1)) & 1)) value -= 1LL << length;
+    return value;
+}
+
+/**
+ *    \fn           unsigned expectEqual(const char* name, long long value, long long expected)
+ *    \brief        Compares value read by an accessor with the expected one
+ *    \param[in]    name
+ *                    Name of the accessor
+ *    \param[in]    value
+ *                    Value read by the accessor
+ *    \param[in]    expected
+ *                    Expected value
+ *    \return       Number of mismatches (0 or 1)
+ */
+static unsigned expectEqual(const char* name, long long value, long long expected)
+{
+    if (value == expected) return 0;
+    cout << name << ": " << value << ", expected " << expected << endl;
+    return 1;
+}
+
+/**
+ *    \fn           unsigned checkMessage(const string& payload, const AISPayloadView& msg)
+ *    \brief        Compares all accessors with the reference decoder
+ *    \param[in]    payload
+ *                    Payload of position report
+ *    \param[in]    msg
+ *                    View of the packed payload
+ *    \return       Number of mismatches
+ */
+static unsigned checkMessage(const string& payload, const AISPayloadView& msg)
+{
+    unsigned errorCnt = 0;
+    errorCnt += expectEqual("messageType", msg.messageType(), referenceField(payload, 0, 6, false));
+    errorCnt += expectEqual("repeatIndicator", msg.repeatIndicator(), referenceField(payload, 6, 2, false));
+    errorCnt += expectEqual("mmsi", msg.mmsi(), referenceField(payload, 8, 30, false));
+    errorCnt += expectEqual("status", msg.status(), referenceField(payload, 38, 4, false));
+    errorCnt += expectEqual("rot", msg.rot(), referenceField(payload, 42, 8, true));
+    errorCnt += expectEqual("sog", msg.sog(), referenceField(payload, 50, 10, false));
+    errorCnt += expectEqual("accuracy", msg.accuracy(), referenceField(payload, 60, 1, false));
+    errorCnt += expectEqual("lon", msg.lon(), referenceField(payload, 61, 28, true));
+    errorCnt += expectEqual("lat", msg.lat(), referenceField(payload, 89, 27, true));
+    errorCnt += expectEqual("cog", msg.cog(), referenceField(payload, 116, 12, false));
+    errorCnt += expectEqual("heading", msg.heading(), referenceField(payload, 128, 9, false));
+    errorCnt += expectEqual("timeStamp", msg.timeStamp(), referenceField(payload, 137, 6, false));
+    errorCnt += expectEqual("maneuver", msg.maneuver(), referenceField(payload, 143, 2, false));
+    errorCnt += expectEqual("bitCnt", static_cast<long long>(msg.bitCnt()), static_cast<long long>(payload.size()*6));
+    return errorCnt;
+}
+
+/**
+ *    \fn           int main()
+ *    \brief        Runs the check
+ *    \return       0 if all accessors match, 1 otherwise
+ */
+int main()
+{
+    unsigned errorCnt = 0;
+    ScratchArena arena;
+
+    // Known position report (MMSI 265547250, 13.9 knots, course 40.4, heading 41, second 53)
+    AISPayloadView known;
+    if (!makePayloadView("13u?etPv2;0n:dDPwUM1U1Cb069D", arena, known)) {
+        cout << "makePayloadView: valid payload rejected" << endl;
+        errorCnt++;
+    }
+    else {
+        errorCnt += expectEqual("known messageType", known.messageType(), 1);
+        errorCnt += expectEqual("known mmsi", known.mmsi(), 265547250);
+        errorCnt += expectEqual("known sog", known.sog(), 139);
+        errorCnt += expectEqual("known cog", known.cog(), 404);
+        errorCnt += expectEqual("known heading", known.heading(), 41);
+        errorCnt += expectEqual("known timeStamp", known.timeStamp(), 53);
+        errorCnt += expectEqual("known isPositionReport", known.isPositionReport(), 1);
+        errorCnt += expectEqual("known contains RadioStatus", known.contains<PositionReportSchema::RadioStatus>(), 1);
+        errorCnt += checkMessage("13u?etPv2;0n:dDPwUM1U1Cb069D", known);
+    }
+
+    // Truncated message holds the header but not the position
+    AISPayloadView truncated;
+    if (!makePayloadView("13u?etPv2;0", arena, truncated)) {
+        cout << "makePayloadView: truncated payload rejected" << endl;
+        errorCnt++;
+    }
+    else {
+        errorCnt += expectEqual("truncated bitCnt", static_cast<long long>(truncated.bitCnt()), 66);
+        errorCnt += expectEqual("truncated mmsi", truncated.mmsi(), 265547250);
+        errorCnt += expectEqual("truncated contains MMSI", truncated.contains<CommonHeaderSchema::MMSI>(), 1);
+        errorCnt += expectEqual("truncated contains PositionAccuracy", truncated.contains<PositionReportSchema::PositionAccuracy>(), 1);
+        errorCnt += expectEqual("truncated contains Longitude", truncated.contains<PositionReportSchema::Longitude>(), 0);
+    }
+    AISPayloadView invalid;
+    errorCnt += expectEqual("makePayloadView invalid character", makePayloadView("13u?e!Pv2", arena, invalid), 0);
+
+    // Random payloads over the whole sixbit alphabet, including all special and negative values
+    std::mt19937 generator(2019);
+    string payload(POSITION_REPORT_CHARS, '0');
+    for (unsigned i = 0; i < RANDOM_MESSAGE_NUM; i++) {
+        for (char& c : payload) {
+            unsigned sixbit = generator() % 64;
+            c = static_cast<char>(sixbit < 40 ? sixbit + 48 : sixbit + 56);
+        }
+        arena.reset();
+        AISPayloadView msg;
+        if (!makePayloadView(payload, arena, msg)) {
+            cout << "makePayloadView: valid payload rejected: " << payload << endl;
+            errorCnt++;
+            continue;
+        }
+        errorCnt += checkMessage(payload, msg);
+    }
+
+    cout << "check_view: " << errorCnt << " mismatches" << endl;
+    return errorCnt == 0 ? 0 : 1;
+}
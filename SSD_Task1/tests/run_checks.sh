@@ -0,0 +1,22 @@
+#!/bin/sh
+# Builds and runs checks of SSD_Task1 modules, with and without AVX2 kernels.
+# Usage: tests/run_checks.sh (from any directory, CXX selects the compiler)
+
+set -e
+DIR=$(cd "$(dirname "$0")" && pwd)
+SRC=$(dirname "$DIR")
+CXX=${CXX:-g++}
+OUT=${TMPDIR:-/tmp}/ssd_task1_checks
+mkdir -p "$OUT"
+
+# Every module except the program entry point
+MODULES=$(ls "$SRC"/*.cpp | grep -v '/main\.cpp$')
+
+for FLAGS in "" "-mavx2"; do
+    for CHECK in "$DIR"/check_*.cpp; do
+        NAME=$(basename "$CHECK" .cpp)
+        echo "== $NAME ${FLAGS:-(scalar)}"
+        $CXX -std=c++17 -O2 -Wall -Wextra -pthread $FLAGS "$CHECK" $MODULES -o "$OUT/$NAME"
+        "$OUT/$NAME"
+    done
+done
@@ -0,0 +1,108 @@
+/**
+ * \file view.hpp
+ *
+ * \brief Lazy view of packed AIS message.
+ *
+ * \details This file includes definition of view over AIS message in binary format which extracts fields only when they are accessed.
+ *
+ * \date    16/10/2026
+ */
+
+#ifndef view_hpp
+#define view_hpp
+
+#include <cstddef>
+#include <string_view>
+#include "main.hpp"
+#include "schema.hpp"
+#include "extraction.hpp"
+#include "arena.hpp"
+
+using std::string_view;
+
+/**
+ *    \class        AISPayloadView
+ *    \brief        Non-owning view of AIS message in binary format extracting fields on access
+ *    \details      Every accessor extracts its field from the packed message with a single load,
+ *                  so code reading only a few fields does not pay for decoding the whole message.
+ *                  Accessors of position fields return values in units of PositionReport and are
+ *                  meaningful for position reports (types 1, 2 and 3) only. Fields of other types
+ *                  can be read with field<F>() using their schemas.
+ *    \warning      Message must be stored in memory of packedPayloadSize() bytes, which stays valid
+ *                  as long as the view is used
+ */
+class AISPayloadView {
+public:
+    AISPayloadView() : m_msg(nullptr), m_bitCnt(0) {}
+    /**
+     *    \fn           AISPayloadView(const byte* msg, size_t bitCnt)
+     *    \brief        Creates view of packed message
+     *    \param[in]    msg
+     *                    AIS message in binary format
+     *    \param[in]    bitCnt
+     *                    Number of bits of the message
+     */
+    AISPayloadView(const byte* msg, size_t bitCnt) : m_msg(msg), m_bitCnt(bitCnt) {}
+
+    /**
+     *    \fn           typename F::value_type field() const
+     *    \brief        Extracts raw value of any field of the schema
+     *    \return       Raw value of the field
+     *    \tparam       F
+     *                    Field of the schema
+     */
+    template <class F>
+    typename F::value_type field() const { return F::extract(m_msg); }
+    /**
+     *    \fn           bool contains() const
+     *    \brief        Checks if message is long enough to hold the field
+     *    \return       Boolean value determining if all bits of the field belong to the message
+     *    \tparam       F
+     *                    Field of the schema
+     */
+    template <class F>
+    bool contains() const { return F::offset + F::length <= m_bitCnt; }
+
+    unsigned messageType() const { return field<CommonHeaderSchema::MessageType>(); }                  /*!< Returns Message Type */
+    unsigned repeatIndicator() const { return field<CommonHeaderSchema::RepeatIndicator>(); }          /*!< Returns Repeat Indicator */
+    unsigned mmsi() const { return field<CommonHeaderSchema::MMSI>(); }                                /*!< Returns MMSI */
+    unsigned status() const { return field<PositionReportSchema::NavigationStatus>(); }                /*!< Returns Navigation Status */
+    int rot() const { return field<PositionReportSchema::RateOfTurn>(); }                              /*!< Returns Rate Of Turn (raw AIS value) */
+    unsigned sog() const { return field<PositionReportSchema::SpeedOverGround>(); }                    /*!< Returns Speed Over Ground [0.1 knot] */
+    unsigned accuracy() const { return field<PositionReportSchema::PositionAccuracy>(); }              /*!< Returns Position Accuracy */
+    int lon() const { return field<PositionReportSchema::Longitude>(); }                               /*!< Returns Longitude [1/10000 min] */
+    int lat() const { return field<PositionReportSchema::Latitude>(); }                                /*!< Returns Latitude [1/10000 min] */
+    unsigned cog() const { return field<PositionReportSchema::CourseOverGround>(); }                   /*!< Returns Course Over Ground [0.1 deg] */
+    unsigned heading() const { return field<PositionReportSchema::TrueHeading>(); }                    /*!< Returns True Heading [deg] */
+    unsigned timeStamp() const { return field<PositionReportSchema::TimeStamp>(); }                    /*!< Returns Time Stamp [s] */
+    unsigned maneuver() const { return field<PositionReportSchema::ManeuverIndicator>(); }             /*!< Returns Maneuver Indicator */
+
+    bool isPositionReport() const { unsigned type = messageType(); return type >= 1 && type <= 3; }   /*!< Checks if message is Position Report Class A */
+    const byte* data() const { return m_msg; }                                                         /*!< Returns packed message */
+    size_t bitCnt() const { return m_bitCnt; }                                                         /*!< Returns number of bits of the message */
+
+private:
+    const byte* m_msg;      /*!< AIS message in binary format */
+    size_t m_bitCnt;        /*!< Number of bits of the message */
+};
+
+/**
+ *    \fn           bool makePayloadView(string_view payload, ScratchArena& arena, AISPayloadView& view)
+ *    \brief        Packs armored payload and creates its view
+ *    \param[in]    payload
+ *                    Payload of AIS message
+ *    \param[in]    arena
+ *                    Arena providing memory for the packed message
+ *    \param[out]    view
+ *                    View of the packed message, valid until the arena is reset
+ *    \return       Boolean value determining if all characters belong to the sixbit alphabet
+ */
+inline bool makePayloadView(string_view payload, ScratchArena& arena, AISPayloadView& view)
+{
+    byte* msgBin = arena.allocate<byte>(packedPayloadSize(payload.length()));
+    if (!convertAISMsgStringToBinaryFormat(payload, msgBin)) return false;
+    view = AISPayloadView(msgBin, payload.length()*6);
+    return true;
+}
+
+#endif /* view_hpp */
@@ -10,73 +10,380 @@
  */
 
 #include <iostream>
-#include <fstream>
-#include <vector>
+#include <cstring>
+#include <algorithm>
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/uio.h>
+#endif
 #include "write.hpp"
 
-using namespace std;
+using std::cout;
+using std::endl;
+using std::to_string;
+using std::lock_guard;
+using std::unique_lock;
+
+#if !defined(_WIN32) && !defined(IOV_MAX)
+#define IOV_MAX 1024
+#endif
+
+VesselFileWriter::VesselFileWriter(const string& outputDirPath, size_t maxOpenFiles, size_t vesselFlushThreshold, size_t bufferBudget)
+: m_outputDirPath(outputDirPath), m_maxOpenFiles(maxOpenFiles > 0 ? maxOpenFiles : 1),
+  m_vesselFlushThreshold(vesselFlushThreshold), m_bufferBudget(bufferBudget),
+  m_openCnt(0), m_pendingBytes(0), m_lruHead(WRITE_NONE), m_lruTail(WRITE_NONE)
+{
+}
+
+VesselFileWriter::~VesselFileWriter()
+{
+    closeAll();
+}
 
 /**
- *    \var      vector<string> writeFiles
- *    \brief    Container storing names of files that program writes to
+ *    \fn           void VesselFileWriter::detach(uint32_t vessel)
+ *    \brief        Removes open file from the usage list
+ *    \param[in]    vessel
+ *                    Index of the vessel
  */
-vector<string> writeFiles;
+void VesselFileWriter::detach(uint32_t vessel)
+{
+    VesselWriterState& state = m_vessels[vessel];
+    if (state.lruPrev != WRITE_NONE) m_vessels[state.lruPrev].lruNext = state.lruNext;
+    else m_lruHead = state.lruNext;
+    if (state.lruNext != WRITE_NONE) m_vessels[state.lruNext].lruPrev = state.lruPrev;
+    else m_lruTail = state.lruPrev;
+    state.lruPrev = state.lruNext = WRITE_NONE;
+}
 
 /**
- *    \fn           void writeToFile(string& content, ofstream& file_writer, ios_base::openmode mode, string outputFilePath)
- *    \brief        Writes content to file
- *    \param[in]    content
- *                    String containing data to be written to file
- *    \param[in]    file_writer
- *                    Writer used for writing content to files
- *    \param[in]    mode
- *                    Mode determining operations performed on the file
- *    \param[in]    outputFilePath
- *                    Path of the output file
+ *    \fn           void VesselFileWriter::pushFront(uint32_t vessel)
+ *    \brief        Puts open file at the front of the usage list
+ *    \param[in]    vessel
+ *                    Index of the vessel
  */
-void writeToFile(string& content, ofstream& file_writer, ios_base::openmode mode, string outputFilePath)
+void VesselFileWriter::pushFront(uint32_t vessel)
 {
-    file_writer.open(outputFilePath, mode);
-    if (file_writer.is_open()) {
-        file_writer << content;
-        file_writer.close();
-    } else {
+    VesselWriterState& state = m_vessels[vessel];
+    state.lruPrev = WRITE_NONE;
+    state.lruNext = m_lruHead;
+    if (m_lruHead != WRITE_NONE) m_vessels[m_lruHead].lruPrev = vessel;
+    else m_lruTail = vessel;
+    m_lruHead = vessel;
+}
+
+/**
+ *    \fn           bool VesselFileWriter::openFile(uint32_t vessel)
+ *    \brief        Makes sure that the vessel's file is open, closing the least recently used one if needed
+ *    \param[in]    vessel
+ *                    Index of the vessel
+ *    \return       Boolean value determining if file is open
+ */
+bool VesselFileWriter::openFile(uint32_t vessel)
+{
+    if (m_vessels[vessel].fd >= 0) {
+        // Mark file as the most recently used
+        if (m_lruHead != vessel) {
+            detach(vessel);
+            pushFront(vessel);
+        }
+        return true;
+    }
+
+    // Close the least recently used file when the limit is reached
+    if (m_openCnt >= m_maxOpenFiles) {
+        uint32_t evicted = m_lruTail;
+        detach(evicted);
+#ifdef _WIN32
+        _close(m_vessels[evicted].fd);
+#else
+        ::close(m_vessels[evicted].fd);
+#endif
+        m_vessels[evicted].fd = -1;
+        m_openCnt--;
+    }
+
+    VesselWriterState& state = m_vessels[vessel];
+    string outputFilePath = m_outputDirPath + to_string(m_vessels.keyAt(vessel)) + ".txt";
+#ifdef _WIN32
+    int flags = _O_WRONLY | _O_CREAT | _O_TEXT | (state.created ? _O_APPEND : _O_TRUNC);
+    state.fd = _open(outputFilePath.c_str(), flags, _S_IREAD | _S_IWRITE);
+#else
+    int flags = O_WRONLY | O_CREAT | (state.created ? O_APPEND : O_TRUNC);
+    state.fd = ::open(outputFilePath.c_str(), flags, 0666);
+#endif
+    if (state.fd < 0) {
         cout << "(WARNING) Could not open file: " << outputFilePath << endl;
+        return false;
     }
+    state.created = true;
+
+    pushFront(vessel);
+    m_openCnt++;
+    return true;
 }
 
 /**
- *    \fn           void putMessageInFile(string& MMSI, string& content, ofstream& file_writer, string outputDirPath)
- *    \brief        Writes content to the file named with given MMSI number
+ *    \fn           uint32_t VesselFileWriter::allocateChunk()
+ *    \brief        Takes empty chunk from the free list or allocates a new one
+ *    \return       Index of the chunk
+ */
+uint32_t VesselFileWriter::allocateChunk()
+{
+    uint32_t chunk;
+    if (!m_freeChunks.empty()) {
+        chunk = m_freeChunks.back();
+        m_freeChunks.pop_back();
+    }
+    else {
+        chunk = static_cast<uint32_t>(m_chunks.size());
+        m_chunks.emplace_back(new BufferChunk);
+    }
+    m_chunks[chunk]->next = WRITE_NONE;
+    m_chunks[chunk]->used = 0;
+    return chunk;
+}
+
+/**
+ *    \fn           bool VesselFileWriter::flushVessel(uint32_t vessel)
+ *    \brief        Writes buffered content of the vessel to its file and releases its chunks
+ *    \param[in]    vessel
+ *                    Index of the vessel
+ *    \return       Boolean value determining if writing was successful
+ */
+bool VesselFileWriter::flushVessel(uint32_t vessel)
+{
+    if (m_vessels[vessel].pendingBytes == 0) return true;
+    bool success = openFile(vessel);
+    VesselWriterState& state = m_vessels[vessel];
+
+#ifdef _WIN32
+    for (uint32_t chunk = state.firstChunk; success && chunk != WRITE_NONE; chunk = m_chunks[chunk]->next) {
+        const BufferChunk& c = *m_chunks[chunk];
+        success = _write(state.fd, c.data, c.used) == static_cast<int>(c.used);
+    }
+#else
+    // Gather chunks of the vessel into as few system calls as possible
+    struct iovec iov[IOV_MAX];
+    uint32_t chunk = state.firstChunk;
+    while (success && chunk != WRITE_NONE) {
+        int iovCnt = 0;
+        for (; chunk != WRITE_NONE && iovCnt < IOV_MAX; chunk = m_chunks[chunk]->next) {
+            iov[iovCnt].iov_base = m_chunks[chunk]->data;
+            iov[iovCnt].iov_len = m_chunks[chunk]->used;
+            iovCnt++;
+        }
+
+        // Repeat after partial writes
+        struct iovec* pos = iov;
+        while (iovCnt > 0) {
+            ssize_t written = writev(state.fd, pos, iovCnt);
+            if (written < 0) {
+                success = false;
+                break;
+            }
+            while (iovCnt > 0 && static_cast<size_t>(written) >= pos->iov_len) {
+                written -= pos->iov_len;
+                pos++;
+                iovCnt--;
+            }
+            if (iovCnt > 0) {
+                pos->iov_base = static_cast<char*>(pos->iov_base) + written;
+                pos->iov_len -= written;
+            }
+        }
+    }
+#endif
+    if (!success) cout << "(WARNING) Could not write file: " << m_outputDirPath << m_vessels.keyAt(vessel) << ".txt" << endl;
+
+    // Release chunks even on failure, so that the budget is not exceeded permanently
+    for (uint32_t chunk = state.firstChunk; chunk != WRITE_NONE; chunk = m_chunks[chunk]->next) {
+        m_freeChunks.push_back(chunk);
+    }
+    m_pendingBytes -= state.pendingBytes;
+    state.firstChunk = state.lastChunk = WRITE_NONE;
+    state.pendingBytes = 0;
+
+    return success;
+}
+
+/**
+ *    \fn           bool VesselFileWriter::write(unsigned MMSI, const char* content, size_t len)
+ *    \brief        Appends content to the buffer of the file named with given MMSI number
  *    \param[in]    MMSI
  *                    MMSI number of sender (name of the file to be written to)
  *    \param[in]    content
- *                    String containing data to be written to file
- *    \param[in]    file_writer
- *                    Writer used for writing content to files
- *    \param[in]    outputDirPath
- *                    Path of the output directory
- *    \note         If program hasn't written to the file named after given MMSI number before
- *                  than new file is created and content is written to it. Otherwise, the content
- *                  is appended to the existing file crated earlier.
- *    \warning      Function uses global variable 'writeFiles'
+ *                    Data to be written to file
+ *    \param[in]    len
+ *                    Length of data in bytes
+ *    \return       Boolean value determining if all triggered flushes were successful
+ *    \note         File is truncated when it is written to for the first time
  */
-void putMessageInFile(string& MMSI, string& content, ofstream& file_writer, string outputDirPath)
+bool VesselFileWriter::write(unsigned MMSI, const char* content, size_t len)
 {
-    bool MMSImatch = false;
-    
-    // Search for matching MMSI among writeFiles to append new message
-    for(int j = 0; j < writeFiles.size(); j++) {
-        if(writeFiles.at(j) == MMSI) {
-            writeToFile(content, file_writer, ios::app, outputDirPath + MMSI + ".txt");
-            MMSImatch = true;
-            break;
+    bool inserted;
+    uint32_t vessel = m_vessels.insert(MMSI, inserted);
+
+    if (!m_vessels[vessel].dirty) {
+        m_vessels[vessel].dirty = true;
+        m_dirtyVessels.push_back(vessel);
+    }
+
+    // Append content to the last chunk of the vessel, adding chunks when it is full
+    while (len > 0) {
+        uint32_t last = m_vessels[vessel].lastChunk;
+        if (last == WRITE_NONE || m_chunks[last]->used == WRITE_BUFFER_CHUNK_SIZE) {
+            uint32_t chunk = allocateChunk();
+            if (last == WRITE_NONE) m_vessels[vessel].firstChunk = chunk;
+            else m_chunks[last]->next = chunk;
+            m_vessels[vessel].lastChunk = last = chunk;
         }
+        BufferChunk& c = *m_chunks[last];
+        size_t copied = std::min<size_t>(len, WRITE_BUFFER_CHUNK_SIZE - c.used);
+        memcpy(c.data + c.used, content, copied);
+        c.used += static_cast<uint32_t>(copied);
+        content += copied;
+        len -= copied;
+        m_vessels[vessel].pendingBytes += copied;
+        m_pendingBytes += copied;
     }
+
+    // Flush buffers exceeding the limits
+    if (m_pendingBytes > m_bufferBudget) return flushAll();
+    if (m_vessels[vessel].pendingBytes > m_vesselFlushThreshold) return flushVessel(vessel);
+    return true;
+}
+
+/**
+ *    \fn           bool VesselFileWriter::flushAll()
+ *    \brief        Writes buffered content of all vessels to their files
+ *    \return       Boolean value determining if writing was successful
+ */
+bool VesselFileWriter::flushAll()
+{
+    bool success = true;
+    for (uint32_t vessel : m_dirtyVessels) {
+        success = flushVessel(vessel) && success;
+        m_vessels[vessel].dirty = false;
+    }
+    m_dirtyVessels.clear();
+    return success;
+}
+
+/**
+ *    \fn           bool VesselFileWriter::closeAll()
+ *    \brief        Flushes all buffers and closes all open files
+ *    \return       Boolean value determining if writing was successful
+ */
+bool VesselFileWriter::closeAll()
+{
+    bool success = flushAll();
+    while (m_lruHead != WRITE_NONE) {
+        uint32_t vessel = m_lruHead;
+        detach(vessel);
+#ifdef _WIN32
+        _close(m_vessels[vessel].fd);
+#else
+        ::close(m_vessels[vessel].fd);
+#endif
+        m_vessels[vessel].fd = -1;
+    }
+    m_openCnt = 0;
+    return success;
+}
+
+OrderedChunkWriter::OrderedChunkWriter(size_t chunkCnt, size_t maxWaitingCnt, VesselFileWriter& file_writer)
+: m_fileWriter(file_writer), m_outputs(chunkCnt), m_nextChunk(0), m_waitingCnt(0), m_maxWaitingCnt(0),
+  m_waitingLimit(std::max<size_t>(maxWaitingCnt, 1)), m_writing(false), m_success(true)
+{
+}
+
+/**
+ *    \fn           void OrderedChunkWriter::waitForTurn(size_t chunk)
+ *    \brief        Waits until output of a part can be kept in memory
+ *    \param[in]    chunk
+ *                    Index of the part about to be processed
+ *    \note         Part may be processed once fewer than maxWaitingCnt parts preceding it are not
+ *                  written yet. Parts must be taken so that the first part which is not written yet
+ *                  is never left to a waiting thread.
+ */
+void OrderedChunkWriter::waitForTurn(size_t chunk)
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_written.wait(lock, [this, chunk]() { return chunk < m_nextChunk + m_waitingLimit; });
+}
+
+/**
+ *    \fn           bool OrderedChunkWriter::commit(size_t chunk, ChunkOutput& output)
+ *    \brief        Takes output of a finished part and writes all parts which are ready
+ *    \param[in]    chunk
+ *                    Index of the part
+ *    \param[in,out] output
+ *                    Output of the part (left empty)
+ *    \return       Boolean value determining if writing was successful so far
+ *    \note         May be called by many threads at once
+ */
+bool OrderedChunkWriter::commit(size_t chunk, ChunkOutput& output)
+{
+    unique_lock<mutex> lock(m_mutex);
+    m_outputs[chunk].reset(new ChunkOutput(std::move(output)));
+    output = ChunkOutput();
+    m_waitingCnt++;
+    m_maxWaitingCnt = std::max(m_maxWaitingCnt, m_waitingCnt);
+    
+    // Thread already writing takes over outputs committed meanwhile
+    if (m_writing) return m_success;
+    m_writing = true;
     
-    // If matching MMSI was not found add new file to writeFiles and write first message to it
-    if(!MMSImatch) {
-        writeToFile(content, file_writer, ios::trunc, outputDirPath + MMSI + ".txt");
-        writeFiles.push_back(MMSI);
+    // Write parts following the last written one, without blocking other threads
+    while (m_nextChunk < m_outputs.size() && m_outputs[m_nextChunk]) {
+        unique_ptr<ChunkOutput> ready = std::move(m_outputs[m_nextChunk]);
+        lock.unlock();
+        bool success = true;
+        for (uint32_t vessel = 0; vessel < ready->size(); vessel++) {
+            success = m_fileWriter.write(ready->keyAt(vessel), (*ready)[vessel].data(), (*ready)[vessel].size()) && success;
+        }
+        ready.reset();
+        lock.lock();
+        m_success = m_success && success;
+        m_nextChunk++;
+        m_waitingCnt--;
+        m_written.notify_all();
+    }
+    m_writing = false;
+    return m_success;
+}
+
+/**
+ *    \fn           bool writeOrderedRecords(const vector<RecordRing*>& rings, VesselFileWriter& file_writer)
+ *    \brief        Writes records received from the rings to files named after their MMSI numbers
+ *    \param[in]    rings
+ *                    Rings carrying records tagged with MMSI numbers, one per producer
+ *    \param[in]    file_writer
+ *                    Writer owning output files
+ *    \return       Boolean value determining if all records were written successfully
+ *    \note         Producers take batches in turns, so batch n is read from ring n % rings.size()
+ *                  up to its RING_TAG_BATCH_END record. This way records are written in the order
+ *                  of the input file. Function returns after the ring of the next batch is closed
+ *                  and drained, all files are closed on return.
+ *    \warning      Intended to be run as the only consumer of the rings in a dedicated writer thread
+ */
+bool writeOrderedRecords(const vector<RecordRing*>& rings, VesselFileWriter& file_writer)
+{
+    bool success = true;
+    RingRecord record;
+    size_t batch = 0;
+    while (rings[batch % rings.size()]->front(record)) {
+        RecordRing& ring = *rings[batch % rings.size()];
+        if (record.tag == RING_TAG_BATCH_END) batch++;
+        else success = file_writer.write(record.tag, record.data, record.len) && success;
+        ring.pop();
     }
+    return file_writer.closeAll() && success;
 }
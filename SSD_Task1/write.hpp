@@ -12,40 +12,251 @@
 #ifndef write_hpp
 #define write_hpp
 
-#include <fstream>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include "registry.hpp"
+#include "ring.hpp"
 
-using namespace std;
+using std::string;
+using std::vector;
+using std::unique_ptr;
+using std::mutex;
+using std::condition_variable;
+
+//! Default maximal number of simultaneously open output files
+#define DEFAULT_MAX_OPEN_FILES 256
+//! Default number of buffered bytes of a single vessel triggering flush of its file
+#define DEFAULT_VESSEL_FLUSH_THRESHOLD (64 * 1024)
+//! Default number of buffered bytes of all vessels triggering flush of all files
+#define DEFAULT_WRITE_BUFFER_BUDGET (64 * 1024 * 1024)
+//! Size of a single chunk of write-back buffers
+#define WRITE_BUFFER_CHUNK_SIZE (4096 - 2*sizeof(uint32_t))
+//! Index of nonexistent vessel or buffer chunk
+#define WRITE_NONE 0xFFFFFFFFu
 
 /**
- *    \fn           void writeToFile(string& content, ofstream& file_writer, ios_base::openmode mode, string outputFilePath)
- *    \brief        Writes content to file
- *    \param[in]    content
- *                    String containing data to be written to file
- *    \param[in]    file_writer
- *                    Writer used for writing content to files
- *    \param[in]    mode
- *                    Mode determining operations performed on the file
- *    \param[in]    outputFilePath
- *                    Path of the output file
+ *    \struct       VesselWriterState
+ *    \brief        Structure for storing state of the output file of a single vessel
+ */
+struct VesselWriterState {
+    int fd = -1;                        /*!< Descriptor of the file (-1 if file is closed) */
+    bool created = false;               /*!< Determines if file was already created by the program */
+    bool dirty = false;                 /*!< Determines if vessel is on the list of buffered vessels */
+    uint32_t lruPrev = WRITE_NONE;      /*!< More recently used open file */
+    uint32_t lruNext = WRITE_NONE;      /*!< Less recently used open file */
+    uint32_t firstChunk = WRITE_NONE;   /*!< First chunk of buffered content */
+    uint32_t lastChunk = WRITE_NONE;    /*!< Last chunk of buffered content */
+    size_t pendingBytes = 0;            /*!< Number of buffered bytes */
+};
+
+/**
+ *    \class        VesselFileWriter
+ *    \brief        Writer buffering output content of every vessel in memory
+ *    \details      Content is appended to per-vessel chains of fixed-size chunks and written
+ *                  with a single gathering system call when the vessel's buffer exceeds the
+ *                  flush threshold. When all buffers together exceed the budget, or on close,
+ *                  all buffered vessels are flushed at once. Output files are kept open and
+ *                  the least recently used one is closed when the limit of open files is hit.
+ *                  State of every vessel is kept in a hash table indexed by MMSI number, so
+ *                  independent writers may coexist.
  */
-void writeToFile(string& content, ofstream& file_writer, ios_base::openmode mode, string outputFilePath);
+class VesselFileWriter {
+public:
+    /**
+     *    \fn           VesselFileWriter(const string& outputDirPath, size_t maxOpenFiles, size_t vesselFlushThreshold, size_t bufferBudget)
+     *    \brief        Creates writer without any buffered content
+     *    \param[in]    outputDirPath
+     *                    Path of the output directory
+     *    \param[in]    maxOpenFiles
+     *                    Maximal number of simultaneously open files
+     *    \param[in]    vesselFlushThreshold
+     *                    Number of buffered bytes of a single vessel triggering flush of its file
+     *    \param[in]    bufferBudget
+     *                    Number of buffered bytes of all vessels triggering flush of all files
+     */
+    VesselFileWriter(const string& outputDirPath, size_t maxOpenFiles = DEFAULT_MAX_OPEN_FILES,
+                     size_t vesselFlushThreshold = DEFAULT_VESSEL_FLUSH_THRESHOLD,
+                     size_t bufferBudget = DEFAULT_WRITE_BUFFER_BUDGET);
+    ~VesselFileWriter();
+    VesselFileWriter(const VesselFileWriter&) = delete;
+    VesselFileWriter& operator=(const VesselFileWriter&) = delete;
+
+    /**
+     *    \fn           bool write(unsigned MMSI, const char* content, size_t len)
+     *    \brief        Appends content to the buffer of the file named with given MMSI number
+     *    \param[in]    MMSI
+     *                    MMSI number of sender (name of the file to be written to)
+     *    \param[in]    content
+     *                    Data to be written to file
+     *    \param[in]    len
+     *                    Length of data in bytes
+     *    \return       Boolean value determining if all triggered flushes were successful
+     *    \note         File is truncated when it is written to for the first time
+     */
+    bool write(unsigned MMSI, const char* content, size_t len);
+    /**
+     *    \fn           bool flushAll()
+     *    \brief        Writes buffered content of all vessels to their files
+     *    \return       Boolean value determining if writing was successful
+     */
+    bool flushAll();
+    /**
+     *    \fn           bool closeAll()
+     *    \brief        Flushes all buffers and closes all open files
+     *    \return       Boolean value determining if writing was successful
+     */
+    bool closeAll();
+
+private:
+    /**
+     *    \struct       BufferChunk
+     *    \brief        Fixed-size piece of write-back buffer
+     */
+    struct BufferChunk {
+        uint32_t next;                          /*!< Next chunk of the same vessel */
+        uint32_t used;                          /*!< Number of used bytes */
+        char data[WRITE_BUFFER_CHUNK_SIZE];     /*!< Buffered content */
+    };
+
+    /**
+     *    \fn           uint32_t allocateChunk()
+     *    \brief        Takes empty chunk from the free list or allocates a new one
+     *    \return       Index of the chunk
+     */
+    uint32_t allocateChunk();
+    /**
+     *    \fn           bool flushVessel(uint32_t vessel)
+     *    \brief        Writes buffered content of the vessel to its file and releases its chunks
+     *    \param[in]    vessel
+     *                    Index of the vessel
+     *    \return       Boolean value determining if writing was successful
+     */
+    bool flushVessel(uint32_t vessel);
+    /**
+     *    \fn           bool openFile(uint32_t vessel)
+     *    \brief        Makes sure that the vessel's file is open, closing the least recently used one if needed
+     *    \param[in]    vessel
+     *                    Index of the vessel
+     *    \return       Boolean value determining if file is open
+     */
+    bool openFile(uint32_t vessel);
+    /**
+     *    \fn           void detach(uint32_t vessel)
+     *    \brief        Removes open file from the usage list
+     *    \param[in]    vessel
+     *                    Index of the vessel
+     */
+    void detach(uint32_t vessel);
+    /**
+     *    \fn           void pushFront(uint32_t vessel)
+     *    \brief        Puts open file at the front of the usage list
+     *    \param[in]    vessel
+     *                    Index of the vessel
+     */
+    void pushFront(uint32_t vessel);
+
+    string m_outputDirPath;                 /*!< Path of the output directory */
+    size_t m_maxOpenFiles;                  /*!< Maximal number of simultaneously open files */
+    size_t m_vesselFlushThreshold;          /*!< Number of buffered bytes of a single vessel triggering flush */
+    size_t m_bufferBudget;                  /*!< Number of buffered bytes of all vessels triggering flush */
+    size_t m_openCnt;                       /*!< Number of open files */
+    size_t m_pendingBytes;                  /*!< Number of buffered bytes of all vessels */
+    uint32_t m_lruHead;                     /*!< Most recently used open file */
+    uint32_t m_lruTail;                     /*!< Least recently used open file */
+    MMSIMap<VesselWriterState> m_vessels;   /*!< State of output files indexed by MMSI number */
+    vector<uint32_t> m_dirtyVessels;        /*!< Vessels with buffered content */
+    vector<unique_ptr<BufferChunk>> m_chunks; /*!< All allocated buffer chunks */
+    vector<uint32_t> m_freeChunks;          /*!< Chunks not used by any vessel */
+};
+
+//! Output content of a part of the input file indexed by MMSI number
+typedef MMSIMap<string> ChunkOutput;
+
+/**
+ *    \class        OrderedChunkWriter
+ *    \brief        Writer committing outputs of parts of the input file in the order of the parts
+ *    \details      Parts may be finished by different threads in any order. Output of a finished part
+ *                  is kept in memory until outputs of all preceding parts are written, so that every
+ *                  file receives content in the order of the input file. Threads take their turn
+ *                  before processing a part, which bounds the number of outputs kept in memory.
+ *                  Outputs are written by one thread at a time with the lock released, so other
+ *                  threads can commit their parts meanwhile.
+ */
+class OrderedChunkWriter {
+public:
+    /**
+     *    \fn           OrderedChunkWriter(size_t chunkCnt, size_t maxWaitingCnt, VesselFileWriter& file_writer)
+     *    \brief        Creates writer waiting for the first part
+     *    \param[in]    chunkCnt
+     *                    Number of parts of the input file
+     *    \param[in]    maxWaitingCnt
+     *                    Maximal number of parts kept in memory at once
+     *    \param[in]    file_writer
+     *                    Writer owning output files
+     */
+    OrderedChunkWriter(size_t chunkCnt, size_t maxWaitingCnt, VesselFileWriter& file_writer);
+    OrderedChunkWriter(const OrderedChunkWriter&) = delete;
+    OrderedChunkWriter& operator=(const OrderedChunkWriter&) = delete;
+
+    /**
+     *    \fn           void waitForTurn(size_t chunk)
+     *    \brief        Waits until output of a part can be kept in memory
+     *    \param[in]    chunk
+     *                    Index of the part about to be processed
+     *    \note         Part may be processed once fewer than maxWaitingCnt parts preceding it are not
+     *                  written yet. Parts must be taken so that the first part which is not written yet
+     *                  is never left to a waiting thread.
+     */
+    void waitForTurn(size_t chunk);
+    /**
+     *    \fn           bool commit(size_t chunk, ChunkOutput& output)
+     *    \brief        Takes output of a finished part and writes all parts which are ready
+     *    \param[in]    chunk
+     *                    Index of the part
+     *    \param[in,out] output
+     *                    Output of the part (left empty)
+     *    \return       Boolean value determining if writing was successful so far
+     *    \note         May be called by many threads at once
+     */
+    bool commit(size_t chunk, ChunkOutput& output);
+    /**
+     *    \fn           size_t maxWaitingCnt() const
+     *    \brief        Returns the highest number of parts kept in memory at once
+     */
+    size_t maxWaitingCnt() const { return m_maxWaitingCnt; }
+
+private:
+    VesselFileWriter& m_fileWriter;             /*!< Writer owning output files */
+    vector<unique_ptr<ChunkOutput>> m_outputs;  /*!< Outputs of finished parts which are not written yet */
+    size_t m_nextChunk;                         /*!< Index of the first part which is not written yet */
+    size_t m_waitingCnt;                        /*!< Number of parts kept in memory */
+    size_t m_maxWaitingCnt;                     /*!< Highest number of parts kept in memory at once */
+    size_t m_waitingLimit;                      /*!< Maximal number of parts kept in memory at once */
+    bool m_writing;                             /*!< Determines if some thread is writing outputs */
+    bool m_success;                             /*!< Determines if all writes were successful */
+    mutex m_mutex;                              /*!< Protects all members except the file writer */
+    condition_variable m_written;               /*!< Signalled when output of a part is written */
+};
 
 /**
- *    \fn           putMessageInFile(string& MMSI, string& content, ofstream& file_writer, string outputDirPath)
- *    \brief        Writes content to the file named with given MMSI number
- *    \param[in]    MMSI
- *                    MMSI number of sender (name of the file to be written to)
- *    \param[in]    content
- *                    String containing data to be written to file
+ *    \fn           bool writeOrderedRecords(const vector<RecordRing*>& rings, VesselFileWriter& file_writer)
+ *    \brief        Writes records received from the rings to files named after their MMSI numbers
+ *    \param[in]    rings
+ *                    Rings carrying records tagged with MMSI numbers, one per producer
  *    \param[in]    file_writer
- *                    Writer used for writing content to files
- *    \param[in]    outputDirPath
- *                    Path of the output directory
- *    \note         If program hasn't written to the file named after given MMSI number before
- *                  than new file is created and content is written to it. Otherwise, the content
- *                  is appended to the existing file crated earlier.
- *    \warning      Function uses global variable 'writeFiles'
+ *                    Writer owning output files
+ *    \return       Boolean value determining if all records were written successfully
+ *    \note         Producers take batches in turns, so batch n is read from ring n % rings.size()
+ *                  up to its RING_TAG_BATCH_END record. This way records are written in the order
+ *                  of the input file. Function returns after the ring of the next batch is closed
+ *                  and drained, all files are closed on return.
+ *    \warning      Intended to be run as the only consumer of the rings in a dedicated writer thread
  */
-void putMessageInFile(string& MMSI, string& content, ofstream& file_writer, string outputDirPath);
+bool writeOrderedRecords(const vector<RecordRing*>& rings, VesselFileWriter& file_writer);
 
 #endif /* write_hpp */